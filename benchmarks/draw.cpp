@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+#include <smk/Color.hpp>
+#include <smk/Font.hpp>
+#include <smk/Framebuffer.hpp>
+#include <smk/Sprite.hpp>
+#include <smk/Text.hpp>
+#include <smk/Texture.hpp>
+#include <string>
+
+#include "asset.hpp"
+
+namespace {
+
+constexpr int dimension = 512;
+
+// Draw N sprites sharing the same texture. glFinish() is called, so that the
+// time spent by the GPU is measured too.
+void BM_DrawSprites(benchmark::State& state) {
+  auto framebuffer = smk::Framebuffer(dimension, dimension);
+  auto texture = smk::Texture(asset::hero_png);
+  auto sprite = smk::Sprite(texture);
+  const int64_t count = state.range(0);
+
+  for (auto _ : state) {
+    framebuffer.Clear(smk::Color::Black);
+    for (int64_t i = 0; i < count; ++i) {
+      sprite.SetPosition(float(i % dimension), float((i * 7) % dimension));
+      framebuffer.Draw(sprite);
+    }
+    glFinish();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_DrawSprites)->RangeMultiplier(10)->Range(1, 10000);
+
+// Draw a Text of N characters.
+void BM_DrawText(benchmark::State& state) {
+  auto framebuffer = smk::Framebuffer(dimension, dimension);
+  auto font = smk::Font(asset::arial_ttf, 16);
+  std::string string;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    string += (i % 64 == 63) ? '\n' : char('a' + i % 26);
+  }
+  auto text = smk::Text(font, string);
+
+  for (auto _ : state) {
+    framebuffer.Clear(smk::Color::Black);
+    framebuffer.Draw(text);
+    glFinish();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DrawText)->RangeMultiplier(10)->Range(10, 10000);
+
+}  // namespace
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
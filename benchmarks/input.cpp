@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+#include <GLFW/glfw3.h>
+#include <smk/InputImpl.hpp>
+
+namespace {
+
+// Update the state of the N keys the application is interested in: letters,
+// then digits.
+void BM_InputUpdate(benchmark::State& state) {
+  // The HeadlessContext created by main() is the current one.
+  GLFWwindow* window = glfwGetCurrentContext();
+
+  smk::InputImpl input;
+  for (int i = 0; i < int(state.range(0)); ++i) {
+    input.IsKeyPressed(i < 26 ? GLFW_KEY_A + i : GLFW_KEY_0 + i - 26);
+  }
+  input.IsMousePressed(GLFW_MOUSE_BUTTON_LEFT);
+
+  for (auto _ : state) {
+    input.Update(window);
+    benchmark::DoNotOptimize(input.cursor());
+  }
+}
+BENCHMARK(BM_InputUpdate)->Arg(1)->Arg(8)->Arg(36);
+
+}  // namespace
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
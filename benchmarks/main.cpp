@@ -0,0 +1,24 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <smk/HeadlessContext.hpp>
+
+// Every benchmark runs on the main thread, with this OpenGL context current.
+//
+// On a server without display, use Mesa's software rasterizer (llvmpipe) and a
+// virtual display:
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ./smk_benchmarks --benchmark_format=json
+int main(int argc, char** argv) {
+  auto context = smk::HeadlessContext();
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return EXIT_FAILURE;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return EXIT_SUCCESS;
+}
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <smk/Bezier.hpp>
+#include <smk/GeometryCache.hpp>
+#include <smk/Shape.hpp>
+#include <vector>
+
+namespace {
+
+std::vector<glm::vec2> Zigzag(size_t size) {
+  std::vector<glm::vec2> points;
+  for (size_t i = 0; i < size; ++i) {
+    points.emplace_back(float(i) * 10.f, (i % 2) ? 20.f : -20.f);
+  }
+  return points;
+}
+
+// Stroke a polyline of N points and upload it. The geometry cache is disabled,
+// so every iteration tessellates the path again.
+void BM_ShapePath(benchmark::State& state) {
+  auto& cache = smk::GeometryCache::Default();
+  const size_t max_size = cache.max_size();
+  cache.SetMaxSize(0);
+
+  const auto points = Zigzag(size_t(state.range(0)));
+  for (auto _ : state) {
+    auto path = smk::Shape::Path(points, 4.f);
+    benchmark::DoNotOptimize(path);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+
+  cache.SetMaxSize(max_size);
+}
+BENCHMARK(BM_ShapePath)->RangeMultiplier(10)->Range(10, 10000);
+
+// The same, when the geometry is found in the cache.
+void BM_ShapePathCached(benchmark::State& state) {
+  const auto points = Zigzag(size_t(state.range(0)));
+  for (auto _ : state) {
+    auto path = smk::Shape::Path(points, 4.f);
+    benchmark::DoNotOptimize(path);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ShapePathCached)->RangeMultiplier(10)->Range(10, 10000);
+
+// Evaluate a cubic Bezier curve into N segments.
+void BM_ShapeBezier(benchmark::State& state) {
+  const std::vector<glm::vec2> control_points = {
+      {0.f, 0.f}, {100.f, 200.f}, {200.f, -200.f}, {300.f, 0.f}};
+  const size_t subdivision = size_t(state.range(0));
+  for (auto _ : state) {
+    auto points = smk::Shape::Bezier(control_points, subdivision);
+    benchmark::DoNotOptimize(points.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ShapeBezier)->RangeMultiplier(10)->Range(10, 10000);
+
+// Flatten a spline of N cubic curves, reusing the output buffer.
+void BM_BezierFlatten(benchmark::State& state) {
+  std::vector<glm::vec2> points;
+  for (int64_t i = 0; i < 3 * state.range(0) + 1; ++i) {
+    points.emplace_back(float(i) * 30.f, std::sin(float(i)) * 100.f);
+  }
+  std::vector<glm::vec2> output;
+  for (auto _ : state) {
+    output.clear();
+    smk::Bezier::Spline(points.data(), points.size(), 0.25f, &output);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BezierFlatten)->RangeMultiplier(10)->Range(1, 1000);
+
+}  // namespace
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include <smk/Font.hpp>
+#include <smk/Texture.hpp>
+#include <vector>
+
+#include "asset.hpp"
+
+namespace {
+
+// Decode a PNG file and upload it.
+void BM_TextureLoadFile(benchmark::State& state) {
+  for (auto _ : state) {
+    auto texture = smk::Texture(asset::hero_png);
+    benchmark::DoNotOptimize(texture.id());
+  }
+}
+BENCHMARK(BM_TextureLoadFile);
+
+// Upload N x N RGBA pixels, and generate the mipmaps.
+void BM_TextureUpload(benchmark::State& state) {
+  const int size = int(state.range(0));
+  std::vector<uint8_t> pixels(size_t(size) * size_t(size) * 4, 128);
+  for (auto _ : state) {
+    auto texture = smk::Texture(pixels.data(), size, size);
+    glFinish();
+  }
+  state.SetBytesProcessed(state.iterations() * int64_t(pixels.size()));
+}
+BENCHMARK(BM_TextureUpload)->RangeMultiplier(4)->Range(16, 1024);
+
+// Load a font, at the given line height.
+void BM_FontConstruction(benchmark::State& state) {
+  for (auto _ : state) {
+    auto font = smk::Font(asset::arial_ttf, float(state.range(0)));
+    benchmark::DoNotOptimize(font.line_height());
+  }
+}
+BENCHMARK(BM_FontConstruction)->Arg(16)->Arg(48)->Arg(128);
+
+}  // namespace
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
@@ -0,0 +1,37 @@
+#include <benchmark/benchmark.h>
+#include <smk/Transformable.hpp>
+
+namespace {
+
+void BM_TransformableTransformation(benchmark::State& state) {
+  smk::Transformable transformable;
+  transformable.SetCenter(16.f, 16.f);
+  transformable.SetScale(2.f, 3.f);
+  float angle = 0.f;
+  for (auto _ : state) {
+    angle += 0.1f;
+    transformable.SetPosition(angle, -angle);
+    transformable.SetRotation(angle);
+    glm::mat4 transformation = transformable.transformation();
+    benchmark::DoNotOptimize(transformation);
+  }
+}
+BENCHMARK(BM_TransformableTransformation);
+
+void BM_Transformable3DTransformation(benchmark::State& state) {
+  smk::Transformable3D transformable;
+  glm::mat4 matrix(1.f);
+  for (auto _ : state) {
+    matrix[3][0] += 0.1f;
+    transformable.SetTransformation(matrix);
+    glm::mat4 transformation = transformable.transformation();
+    benchmark::DoNotOptimize(transformation);
+  }
+}
+BENCHMARK(BM_Transformable3DTransformation);
+
+}  // namespace
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
@@ -1,3 +1,4 @@
+#include <smk/Bezier.hpp>
 #include <smk/Color.hpp>
 #include <smk/Shape.hpp>
 #include <smk/Window.hpp>
@@ -6,6 +7,9 @@ int main() {
   // Open a new window.
   auto window = smk::Window(640, 480, "test");
 
+  // Reused from one frame to the next.
+  std::vector<glm::vec2> bezier;
+
   window.ExecuteMainLoop([&] {
     window.PoolEvents();
     window.Clear(smk::Color::RGB(0.1f, 0.1f, 0.1f));
@@ -13,14 +17,14 @@ int main() {
     float y = 0.5f + 0.4f * sin(window.time());
 
     // Draw a bezier path
-    auto bezier = smk::Shape::Bezier(
-        {
-            {10, 10},
-            {630 * y, 10},
-            {10, 480 * y},
-            {630, 480 * y},
-        },
-        50);
+    const glm::vec2 control_points[] = {
+        {10, 10},
+        {630 * y, 10},
+        {10, 480 * y},
+        {630, 480 * y},
+    };
+    bezier.clear();
+    smk::Bezier::Flatten(control_points, 4, /*tolerance=*/0.25f, &bezier);
 
     auto bezier_path_foreground = smk::Shape::Path(bezier, 10);
     auto bezier_path_background = smk::Shape::Path(bezier, 20);
@@ -0,0 +1,54 @@
+#include <smk/Color.hpp>
+#include <smk/DamageTracker.hpp>
+#include <smk/Input.hpp>
+#include <smk/Shape.hpp>
+#include <smk/Window.hpp>
+#include <vector>
+
+// A mostly static scene. Only the pixels around the cursor are drawn again.
+int main() {
+  auto window = smk::Window(640, 480, "Damage tracker");
+  window.SetOnDemandRendering(true);
+
+  // The static background: a lot of squares.
+  std::vector<smk::Transformable> squares;
+  for (int y = 0; y < 48; ++y) {
+    for (int x = 0; x < 64; ++x) {
+      auto square = smk::Shape::Square();
+      square.SetPosition(x * 10.f + 1.f, y * 10.f + 1.f);
+      square.SetScale(8.f, 8.f);
+      square.SetColor(smk::Color::RGBA(x / 64.f, y / 48.f, 0.5f, 1.f));
+      squares.push_back(square);
+    }
+  }
+
+  auto cursor = smk::Shape::Circle(20);
+  cursor.SetColor(smk::Color::White);
+
+  smk::DamageTracker damage;
+
+  window.ExecuteMainLoop([&] {
+    window.PoolEvents();
+
+    // The cursor moved: redraw where it was and where it is.
+    damage.Invalidate(window, cursor);
+    cursor.SetPosition(window.input().mouse());
+    damage.Invalidate(window, cursor);
+
+    damage.Draw(window, [&](smk::RenderTarget& target) {
+      // Only the squares intersecting the damaged regions are drawn.
+      target.Clear(smk::Color::Black);
+      for (const auto& square : squares) {
+        target.Draw(square);
+      }
+      target.Draw(cursor);
+    });
+
+    window.Display();
+  });
+  return EXIT_SUCCESS;
+}
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
@@ -0,0 +1,37 @@
+#include <cstdio>
+#include <smk/Color.hpp>
+#include <smk/Framebuffer.hpp>
+#include <smk/HeadlessContext.hpp>
+#include <smk/Shape.hpp>
+
+// Render an image without opening any window and write it as a PPM file.
+int main() {
+  auto context = smk::HeadlessContext();
+
+  int dim = 256;
+  auto framebuffer = smk::Framebuffer(dim, dim);
+  framebuffer.Clear(smk::Color::Black);
+
+  auto circle = smk::Shape::Circle(dim * 0.4);
+  circle.SetPosition(dim * 0.5, dim * 0.5);
+  circle.SetColor(smk::Color::Yellow);
+  framebuffer.Draw(circle);
+
+  std::vector<uint8_t> pixels =
+      framebuffer.ReadPixels({0.f, 0.f, float(dim), float(dim)});
+
+  FILE* file = fopen("headless.ppm", "wb");
+  if (!file) {
+    return EXIT_FAILURE;
+  }
+  fprintf(file, "P6\n%d %d\n255\n", dim, dim);
+  for (size_t i = 0; i < pixels.size(); i += 4) {
+    fwrite(&pixels[i], 1, 3, file);
+  }
+  fclose(file);
+  return EXIT_SUCCESS;
+}
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
@@ -0,0 +1,37 @@
+#include <cmath>
+#include <smk/Color.hpp>
+#include <smk/Input.hpp>
+#include <smk/Shape.hpp>
+#include <smk/Window.hpp>
+
+// Draw only when something changes. While idle, the CPU sleeps.
+int main() {
+  auto window = smk::Window(640, 480, "On demand rendering");
+  window.SetOnDemandRendering(true);
+
+  auto circle = smk::Shape::Circle(30);
+  float start = 0.f;
+
+  window.ExecuteMainLoop([&] {
+    window.PoolEvents();
+
+    // Press space to make the circle bounce during 2 seconds.
+    if (window.input().IsKeyPressed(GLFW_KEY_SPACE)) {
+      start = window.time();
+      window.RequestAnimation(2.f);
+    }
+    float t = window.time() - start;
+    float bounce = t < 2.f ? std::abs(std::sin(t * 6.f)) * 100.f * (2.f - t)
+                           : 0.f;
+
+    window.Clear(smk::Color::Black);
+    circle.SetPosition(window.input().mouse() - glm::vec2(0.f, bounce));
+    window.Draw(circle);
+    window.Display();
+  });
+  return EXIT_SUCCESS;
+}
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
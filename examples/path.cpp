@@ -21,7 +21,12 @@ int main() {
         window.input().cursor(),
     };
 
-    auto path_white = smk::Shape::Path(points, 30);
+    smk::Stroker::Style style;
+    style.thickness = 30;
+    style.join = smk::Stroker::Join::Round;
+    style.cap = smk::Stroker::Cap::Round;
+
+    auto path_white = smk::Shape::Path(points, style);
     auto path_black = smk::Shape::Path(points, 5);
 
     path_black.SetColor({0.f, 0.f, 0.f, 1.f});
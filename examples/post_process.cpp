@@ -0,0 +1,53 @@
+#include <cmath>
+#include <smk/BlendMode.hpp>
+#include <smk/Color.hpp>
+#include <smk/Framebuffer.hpp>
+#include <smk/Input.hpp>
+#include <smk/PostProcessChain.hpp>
+#include <smk/Shape.hpp>
+#include <smk/Sprite.hpp>
+#include <smk/Window.hpp>
+
+int main() {
+  int dim = 512;
+  auto window = smk::Window(dim, dim, "Post-processing example");
+
+  // The scene is drawn into a framebuffer, then post-processed.
+  auto framebuffer = smk::Framebuffer(dim, dim);
+
+  // A glow: the scene is blurred at half resolution and added on top of
+  // itself.
+  auto glow = smk::PostProcessChain();
+  glow.AddGaussianBlur(6.f, 0.5f);
+
+  auto circle = smk::Shape::Circle(dim * 0.05);
+
+  window.ExecuteMainLoop([&] {
+    window.PoolEvents();
+
+    // ----Draw the scene ------------------------------------------------------
+    framebuffer.Clear(smk::Color::Black);
+    for (int i = 0; i < 8; ++i) {
+      float angle = window.time() + i * 2.f * 3.1415f / 8.f;
+      circle.SetPosition(dim * (0.5f + 0.3f * std::cos(angle)),
+                         dim * (0.5f + 0.3f * std::sin(angle)));
+      circle.SetColor({0.5f + 0.5f * std::cos(angle), 0.5f,
+                       0.5f + 0.5f * std::sin(angle), 1.f});
+      framebuffer.Draw(circle);
+    }
+    circle.SetPosition(window.input().cursor());
+    circle.SetColor(smk::Color::White);
+    framebuffer.Draw(circle);
+
+    // ----Draw to the window --------------------------------------------------
+    window.Clear(smk::Color::Black);
+    window.Draw(smk::Sprite(framebuffer));
+    glow.Apply(framebuffer.color_texture(), window, smk::BlendMode::Add);
+    window.Display();
+  });
+  return EXIT_SUCCESS;
+}
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
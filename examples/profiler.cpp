@@ -0,0 +1,61 @@
+#include <cmath>
+#include <smk/Color.hpp>
+#include <smk/Font.hpp>
+#include <smk/Input.hpp>
+#include <smk/Profiler.hpp>
+#include <smk/Shape.hpp>
+#include <smk/View.hpp>
+#include <smk/Window.hpp>
+
+#include "asset.hpp"
+
+int main() {
+  auto window = smk::Window(640, 480, "Profiler");
+  auto font = smk::Font(asset::arial_ttf, 16);
+  auto profiler = smk::Profiler();
+
+  auto circle = smk::Shape::Circle(10);
+  circle.SetBlendMode(smk::BlendMode::Add);
+
+  float time = 0.f;
+
+  window.ExecuteMainLoop([&] {
+    profiler.BeginFrame();
+    window.PoolEvents();
+    window.Clear(smk::Color::Black);
+    time += 0.016f;
+
+    {
+      auto scope = profiler.Scope("circles");
+      smk::View view;
+      view.SetCenter(window.dimensions() * 0.5f);
+      view.SetSize(window.dimensions());
+      window.SetView(view);
+      for (int i = 0; i < 2000; ++i) {
+        circle.SetPosition(320.f + 200.f * std::cos(time + i * 0.37f),
+                           240.f + 200.f * std::sin(time * 1.3f + i * 0.11f));
+        circle.SetColor(smk::Color::RGBA(0.2f, 0.4f, 1.f, 0.05f));
+        window.Draw(circle);
+      }
+    }
+
+    {
+      auto scope = profiler.Scope("overlay");
+      profiler.DrawOverlay(window, font);
+    }
+
+    profiler.EndFrame();
+    window.Display();
+
+    // Press S to save the frames. Open the file in chrome://tracing.
+    if (window.input().IsKeyPressed(GLFW_KEY_S)) {
+      profiler.SaveChromeTrace("profiler.json");
+    }
+  });
+
+  return EXIT_SUCCESS;
+}
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
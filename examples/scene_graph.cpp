@@ -0,0 +1,53 @@
+#include <cmath>
+#include <smk/Color.hpp>
+#include <smk/SceneGraph.hpp>
+#include <smk/Shape.hpp>
+#include <smk/Window.hpp>
+
+int main() {
+  auto window = smk::Window(640, 480, "smk/example/scene_graph");
+  auto scene = smk::SceneGraph();
+
+  // A panel made of 5000 elements.
+  auto background = smk::Shape::Square();
+  background.SetScale(200, 200);
+  background.SetCenter(0.5f, 0.5f);
+  background.SetColor({0.2f, 0.2f, 0.3f, 1.f});
+  auto panel = scene.Add(background);
+
+  auto element = smk::Shape::Square();
+  element.SetScale(2, 2);
+  for (int y = 0; y < 50; ++y) {
+    for (int x = 0; x < 100; ++x) {
+      element.SetPosition(x * 4.f - 200.f, y * 4.f - 100.f);
+      element.SetColor({x / 100.f, y / 50.f, 1.f, 1.f});
+      scene.Add(element, panel);
+    }
+  }
+
+  // A satellite orbiting around the panel.
+  auto orbit = scene.Add(smk::Transformable(), panel);
+  auto satellite = smk::Shape::Circle(20);
+  satellite.SetPosition(250, 0);
+  satellite.SetColor(smk::Color::Yellow);
+  scene.Add(satellite, orbit);
+
+  window.ExecuteMainLoop([&] {
+    window.PoolEvents();
+
+    // Only two nodes are modified. Their subtrees follow.
+    float time = window.time();
+    scene.SetPosition(panel, {320.f + 100.f * std::cos(time), 240.f});
+    scene.SetRotation(orbit, time * 90.f);
+
+    window.Clear(smk::Color::Black);
+    window.Draw(scene);
+    window.Display();
+  });
+
+  return EXIT_SUCCESS;
+}
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
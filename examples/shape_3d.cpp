@@ -27,6 +27,14 @@ int main() {
   cube.SetTexture(texture);
   sphere.SetTexture(texture);
 
+  // Solid objects: drawn from front to back by the depth sorting, writing the
+  // depth.
+  cube.SetBlendMode(smk::BlendMode::Replace);
+  sphere.SetBlendMode(smk::BlendMode::Replace);
+
+  window.SetDepthTest(true);
+  window.SetCullFace(GL_BACK);
+
   float animation = 0.f;
   float animation_df = 0.2f;
   float time = 0.f;
@@ -34,9 +42,6 @@ int main() {
   window.ExecuteMainLoop([&] {
     window.PoolEvents();
     window.Clear(smk::Color::Black);
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-    glEnable(GL_CULL_FACE);
 
     animation += animation_df;
     animation_df -= animation * 0.0005;
@@ -45,6 +50,8 @@ int main() {
     window.SetView(glm::perspective(
         70.f, float(window.width()) / window.height(), 0.1f, 100.f));
 
+    window.BeginDepthSorting();
+
     // Draw the cube.
     {
       glm::mat4 v(1.f);
@@ -69,6 +76,8 @@ int main() {
       }
     }
 
+    window.EndDepthSorting();
+
     window.Display();
   });
 
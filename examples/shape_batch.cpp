@@ -0,0 +1,45 @@
+#include <cmath>
+#include <smk/Color.hpp>
+#include <smk/ShapeBatch.hpp>
+#include <smk/Window.hpp>
+
+int main() {
+  // The shapes are antialiased by the ShapeBatch. Multisampling isn't needed.
+  auto window = smk::Window(640, 480, "smk/example/shape_batch", /*samples=*/0);
+
+  auto batch = smk::ShapeBatch();
+
+  // A grid of buttons.
+  for (int y = 0; y < 8; ++y) {
+    for (int x = 0; x < 6; ++x) {
+      size_t button = batch.AddRoundedRectangle(
+          {70.f + 100.f * x, 40.f + 50.f * y}, {90.f, 40.f}, 4.f + 2.f * x);
+      batch.SetColor(button, {0.2f, 0.3f, 0.1f * y, 1.f});
+      batch.SetBorder(button, 1.f + y * 0.5f, smk::Color::White);
+    }
+  }
+
+  // Circles and lines.
+  for (int i = 0; i < 16; ++i) {
+    float angle = i * 2.f * 3.1415f / 16.f;
+    glm::vec2 direction = {std::cos(angle), std::sin(angle)};
+    glm::vec2 center = {320.f, 240.f};
+    batch.AddLine(center + 30.f * direction, center + 200.f * direction, 2.f);
+    size_t circle = batch.AddCircle(center + 200.f * direction, 10.f);
+    batch.SetColor(circle, smk::Color::Yellow);
+    batch.SetBorder(circle, 3.f, smk::Color::Red);
+  }
+
+  window.ExecuteMainLoop([&] {
+    window.PoolEvents();
+    window.Clear(smk::Color::Black);
+    window.Draw(batch);
+    window.Display();
+  });
+
+  return EXIT_SUCCESS;
+}
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <smk/Color.hpp>
+#include <smk/Input.hpp>
+#include <smk/SpatialScene.hpp>
+#include <smk/Sprite.hpp>
+#include <smk/Texture.hpp>
+#include <smk/View.hpp>
+#include <smk/Window.hpp>
+
+#include "asset.hpp"
+
+int main() {
+  int width = 640;
+  int height = 480;
+  auto window = smk::Window(width, height, "smk/example/spatial_scene");
+  auto texture = smk::Texture(asset::hero_png);
+
+  // A large world, with many sprites. Only the visible ones are drawn.
+  const float world_size = 20000.f;
+  auto scene = smk::SpatialScene(256.f);
+  auto sprite = smk::Sprite(texture);
+  for (int i = 0; i < 100000; ++i) {
+    sprite.SetPosition(world_size * (std::rand() / float(RAND_MAX)),
+                       world_size * (std::rand() / float(RAND_MAX)));
+    scene.Add(sprite);
+  }
+
+  auto center = glm::vec2(world_size * 0.5f, world_size * 0.5f);
+  auto view = smk::View();
+  view.SetSize(width, height);
+
+  window.ExecuteMainLoop([&] {
+    window.PoolEvents();
+
+    // Pan the view using the arrow keys.
+    const float speed = 10.f;
+    if (window.input().IsKeyHold(GLFW_KEY_LEFT))
+      center.x -= speed;
+    if (window.input().IsKeyHold(GLFW_KEY_RIGHT))
+      center.x += speed;
+    if (window.input().IsKeyHold(GLFW_KEY_UP))
+      center.y -= speed;
+    if (window.input().IsKeyHold(GLFW_KEY_DOWN))
+      center.y += speed;
+    view.SetCenter(center);
+    window.SetView(view);
+
+    // Remove the sprites under the mouse.
+    if (window.input().IsCursorHeld()) {
+      glm::vec2 cursor = window.input().cursor() + center -
+                         glm::vec2(width * 0.5f, height * 0.5f);
+      for (auto handle : scene.Query(cursor)) {
+        scene.Remove(handle);
+      }
+    }
+
+    window.Clear(smk::Color::Black);
+    window.Draw(scene);
+    window.Display();
+  });
+
+  return EXIT_SUCCESS;
+}
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
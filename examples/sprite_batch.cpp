@@ -0,0 +1,55 @@
+#include <cstdlib>
+#include <smk/Color.hpp>
+#include <smk/SpriteBatch.hpp>
+#include <smk/Texture.hpp>
+#include <smk/Window.hpp>
+#include <vector>
+
+#include "asset.hpp"
+
+int main() {
+  const float width = 640.f;
+  const float height = 480.f;
+  auto window = smk::Window(int(width), int(height), "smk/example/sprite_batch");
+  auto texture = smk::Texture(asset::hero_png);
+
+  auto random = [](float max) { return max * std::rand() / float(RAND_MAX); };
+
+  // Many sprites, moving every frames.
+  const size_t count = 100000;
+  auto batch = smk::SpriteBatch(texture);
+  std::vector<glm::vec2> speeds;
+  batch.Reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    size_t index = batch.Add({random(width), random(height)});
+    batch.SetCenter(index, {texture.width() / 2.f, texture.height() / 2.f});
+    batch.SetRotation(index, random(360.f));
+    batch.SetScale(index, {0.25f, 0.25f});
+    batch.SetColor(index, {random(1.f), random(1.f), 1.f, 1.f});
+    speeds.emplace_back(random(2.f) - 1.f, random(2.f) - 1.f);
+  }
+
+  window.ExecuteMainLoop([&] {
+    window.PoolEvents();
+
+    // Bulk update, using the positions array directly.
+    glm::vec2* positions = batch.positions();
+    for (size_t i = 0; i < batch.size(); ++i) {
+      positions[i] += speeds[i];
+      if (positions[i].x < 0.f || positions[i].x > width)
+        speeds[i].x = -speeds[i].x;
+      if (positions[i].y < 0.f || positions[i].y > height)
+        speeds[i].y = -speeds[i].y;
+    }
+
+    window.Clear(smk::Color::Black);
+    window.Draw(batch);
+    window.Display();
+  });
+
+  return EXIT_SUCCESS;
+}
+
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
@@ -0,0 +1,78 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_BEZIER_HPP
+#define SMK_BEZIER_HPP
+
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace smk {
+
+/// @brief Evaluate Bezier curves and splines into caller provided buffers.
+///
+/// The control points of curves up to degree 7 are converted once into the
+/// power basis. Every sample is then evaluated independently using Horner's
+/// method. Curves of higher degree use de Casteljau's algorithm. Curves with up
+/// to Bezier::max_control_points control points are evaluated without
+/// allocating memory.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// std::vector<glm::vec2> polyline;  // Reused in between frames.
+/// for (const Connection& connection : connections) {
+///   const glm::vec2 control_points[4] = {
+///       connection.from,
+///       connection.from + glm::vec2(100.f, 0.f),
+///       connection.to - glm::vec2(100.f, 0.f),
+///       connection.to,
+///   };
+///   polyline.clear();
+///   smk::Bezier::Flatten(control_points, 4, /*tolerance=*/0.25f, &polyline);
+///   stroker.Add(polyline);
+/// }
+/// ~~~
+namespace Bezier {
+
+// The curves with more control points need a temporary buffer.
+constexpr size_t max_control_points = 16;
+
+// Write |subdivision| + 1 points, evenly spaced in parameter, into |output|.
+void Evaluate(const glm::vec2* control_points,
+              size_t size,
+              size_t subdivision,
+              glm::vec2* output);
+
+// The number of segments needed for the polyline to stay within |tolerance|
+// of the curve.
+size_t Subdivisions(const glm::vec2* control_points,
+                    size_t size,
+                    float tolerance);
+
+// Append a polyline within |tolerance| of the curve to |output|.
+void Flatten(const glm::vec2* control_points,
+             size_t size,
+             float tolerance,
+             std::vector<glm::vec2>* output);
+
+// Append a polyline within |tolerance| of a piecewise cubic Bezier spline to
+// |output|. The |size| = 3 * n + 1 points are: P0, C0, C0', P1, C1, C1', P2...
+void Spline(const glm::vec2* points,
+            size_t size,
+            float tolerance,
+            std::vector<glm::vec2>* output);
+
+// Append a polyline within |tolerance| of the Catmull-Rom spline passing
+// through every |points| to |output|.
+void CatmullRom(const glm::vec2* points,
+                size_t size,
+                float tolerance,
+                std::vector<glm::vec2>* output);
+
+}  // namespace Bezier
+}  // namespace smk
+
+#endif /* end of include guard: SMK_BEZIER_HPP */
@@ -5,6 +5,7 @@
 #ifndef SMK_COLOR_HPP
 #define SMK_COLOR_HPP
 
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace smk {
@@ -13,6 +14,9 @@ namespace Color {
 glm::vec4 RGBA(float red, float green, float blue, float alpha);
 glm::vec4 RGB(float red, float green, float blue);
 
+// Pack a color into 8 bits per channel, red in the lowest byte.
+uint32_t Pack(const glm::vec4& color);
+
 // Predefined colors.
 extern const glm::vec4 White;
 extern const glm::vec4 Black;
@@ -0,0 +1,95 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_DAMAGE_TRACKER_HPP
+#define SMK_DAMAGE_TRACKER_HPP
+
+#include <functional>
+#include <glm/glm.hpp>
+#include <memory>
+#include <smk/Framebuffer.hpp>
+#include <smk/Rectangle.hpp>
+#include <vector>
+
+namespace smk {
+
+class RenderTarget;
+class TransformableBase;
+
+/// @example damage_tracker.cpp
+
+/// @brief Redraw only the regions of the screen that changed.
+///
+/// The frames are drawn into a persistent Framebuffer. The application reports
+/// the regions whose content changed. Only those are drawn again, with a
+/// scissor rectangle: the drawables outside of it are skipped. The Framebuffer
+/// is then copied to the screen, whose back buffer isn't preserved in between
+/// frames.
+///
+/// The damaged regions are merged, so that at most a few rectangles are drawn.
+/// The Framebuffer isn't multisampled.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// smk::DamageTracker damage;
+///
+/// window.ExecuteMainLoop([&] {
+///   window.PoolEvents();
+///
+///   // Report the pixels the sprite covered, and the ones it covers now.
+///   damage.Invalidate(window, sprite);
+///   sprite.SetPosition(window.input().mouse());
+///   damage.Invalidate(window, sprite);
+///
+///   damage.Draw(window, [&](smk::RenderTarget& target) {
+///     target.Clear(smk::Color::Black);
+///     target.Draw(background);
+///     target.Draw(sprite);
+///   });
+///   window.Display();
+/// });
+/// ~~~
+class DamageTracker {
+ public:
+  DamageTracker();
+  explicit DamageTracker(size_t max_rectangles);
+
+  // Report a region to draw again, in pixels. (0,0) is the top-left corner.
+  void Invalidate(const Rectangle& region);
+  // Report the pixels currently covered by |drawable|, as drawn in |target|.
+  // Only its vertex_array() is considered. For smk::Text, whose glyphs aren't
+  // in it, pass the bounds explicitly.
+  void Invalidate(const RenderTarget& target,
+                  const TransformableBase& drawable);
+  void Invalidate(const RenderTarget& target,
+                  const Rectangle& bounding_box,
+                  const glm::mat4& transformation);
+  void InvalidateAll();
+
+  // The regions to draw again during the next frame.
+  bool empty() const { return !everything_ && rectangles_.empty(); }
+  const std::vector<Rectangle>& rectangles() const { return rectangles_; }
+
+  // Call |draw| once per damaged region, with the scissor set, to update the
+  // persistent Framebuffer. Then copy it into |target|.
+  void Draw(RenderTarget& target,
+            const std::function<void(RenderTarget&)>& draw);
+
+  // The fraction of the pixels drawn during the last frame.
+  float redrawn_fraction() const { return redrawn_fraction_; }
+
+ private:
+  void Merge();
+
+  size_t max_rectangles_ = 0;
+  bool everything_ = true;
+  std::vector<Rectangle> rectangles_;
+  std::unique_ptr<Framebuffer> framebuffer_;
+  float redrawn_fraction_ = 1.f;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_DAMAGE_TRACKER_HPP */
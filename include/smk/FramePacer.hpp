@@ -0,0 +1,108 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_FRAME_PACER_HPP
+#define SMK_FRAME_PACER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace smk {
+
+/// @brief Schedule the frames: synchronize them with the screen refresh rate,
+/// and/or cap their rate. Collect frame time statistics.
+///
+/// The frame rate cap uses deadlines on a monotonic clock. The thread sleeps
+/// until shortly before the deadline, then spins until it is reached. The
+/// spinning duration adapts to the observed sleep overshoot.
+///
+/// Every smk::Window owns one, used by Window::ExecuteMainLoop(). By default,
+/// vsync is enabled and the frame rate isn't capped. With vsync, the frame rate
+/// is still capped a bit above the refresh rate, for the drivers ignoring the
+/// swap interval.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// window.frame_pacer().SetVSync(smk::FramePacer::VSync::Off);
+/// window.frame_pacer().SetFrameRateLimit(144.f);
+///
+/// window.ExecuteMainLoop([&] {
+///   [...]
+///   auto statistics = window.frame_pacer().statistics();
+///   std::cout << statistics.p99 * 1000.f << "ms" << std::endl;
+/// });
+/// ~~~
+class FramePacer {
+ public:
+  enum class VSync {
+    Off,       ///< Present immediately.
+    On,        ///< Wait for the vertical blank.
+    Adaptive,  ///< Like On, but present late frames immediately (tearing)
+               ///< instead of waiting for the next vertical blank. Fall back
+               ///< to On when unsupported.
+  };
+
+  // Frame times, in seconds, over the last frames.
+  struct Statistics {
+    size_t frames = 0;
+    float mean = 0.f;
+    float p99 = 0.f;
+    float max = 0.f;
+    // The frames lasting more than 1.5 target period. The target period is
+    // the frame rate cap, or else the refresh period with vsync.
+    size_t missed_deadlines = 0;
+  };
+
+  FramePacer();
+  explicit FramePacer(size_t history);
+
+  // Apply to the OpenGL context current on the calling thread.
+  void SetVSync(VSync vsync);
+  VSync vsync() const { return vsync_; }
+
+  // Zero or negative disables the cap.
+  void SetFrameRateLimit(float fps);
+  float frame_rate_limit() const { return frame_rate_limit_; }
+
+  // Wait for the deadline of the next frame, and record the frame time.
+  void Wait();
+
+  // Don't record the time elapsed until the next Wait(), e.g. while idling.
+  void Resume();
+
+  // The number of calls to Wait().
+  uint64_t frame_count() const { return frame_count_; }
+
+  Statistics statistics() const;
+  void ResetStatistics();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+
+  void SleepUntil(Clock::time_point deadline);
+  void Record(Clock::time_point now);
+  double FrameRateCap() const;
+  Seconds TargetPeriod() const;
+
+  VSync vsync_ = VSync::On;
+  float frame_rate_limit_ = 0.f;
+  float refresh_rate_ = 60.f;
+
+  uint64_t frame_count_ = 0;
+  bool resumed_ = false;
+  Clock::time_point deadline_;
+  Clock::time_point last_frame_;
+  Seconds spin_duration_;
+
+  std::vector<float> frame_times_;  // Circular buffer.
+  size_t frame_times_index_ = 0;
+  size_t history_ = 0;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_FRAME_PACER_HPP */
@@ -9,16 +9,54 @@
 #include <smk/OpenGL.hpp>
 #include <smk/RenderTarget.hpp>
 #include <smk/Texture.hpp>
+#include <vector>
 
 namespace smk {
 
 /// @example framebuffer.cpp
 
 /// An off-screen drawable area. You can also draw it later in a smk::Sprite.
+///
+/// Multiple render targets:
+/// ------------------------
+/// When constructed from several color textures, each one is bound to its own
+/// color attachment (GL_COLOR_ATTACHMENT0 + i). A fragment shader can write to
+/// all of them at once using `layout(location = i) out vec4 ...`.
+///
+/// Multisampling:
+/// --------------
+/// A multisampled Framebuffer stores its pixels into renderbuffers instead of
+/// textures. It can't be sampled directly. Its content must be resolved into a
+/// regular Framebuffer with the same dimensions first:
+///
+/// ~~~cpp
+/// auto msaa = smk::Framebuffer(640, 480, /*samples=*/4);
+/// auto resolved = smk::Framebuffer(640, 480);
+///
+/// msaa.Clear(smk::Color::Black);
+/// msaa.Draw(scene);
+/// msaa.ResolveTo(resolved);
+///
+/// window.Draw(smk::Sprite(resolved));
+/// ~~~
 class Framebuffer : public RenderTarget {
  public:
+  struct Option {
+    GLint internal_format = GL_RGB8;
+    GLint format = GL_RGB;
+    GLint type = GL_UNSIGNED_BYTE;
+    int samples = 0;
+    int color_attachments = 1;
+    // When false, no depth-stencil renderbuffer is allocated. This is enough
+    // for 2D drawing. See Framebuffer::AttachDepthStencil.
+    bool depth_stencil = true;
+  };
+
   explicit Framebuffer(int width, int height);
+  Framebuffer(int width, int height, const Option& option);
   Framebuffer(std::vector<Texture> color_textures);
+  Framebuffer(int width, int height, int samples);
+  Framebuffer(int width, int height, int samples, int color_attachments);
   ~Framebuffer();
 
   // Move only ressource.
@@ -28,11 +66,26 @@ class Framebuffer : public RenderTarget {
   void operator=(const Framebuffer&) = delete;
 
   smk::Texture& color_texture();
+  const std::vector<Texture>& color_textures() const;
+  int samples() const;
+  const Option& option() const;
+
+  // Allocate the depth-stencil renderbuffer, if not already done.
+  void AttachDepthStencil();
+
+  // Copy every color attachments into |target|. This resolves multisampled
+  // Framebuffer into regular ones.
+  void ResolveTo(Framebuffer& target);
 
  private:
-  void Init();
+  void Init(int width, int height);
+  void AllocateDepthStencil();
   GLuint render_buffer_ = 0;
   std::vector<smk::Texture> color_textures_;
+  Option option_;
+
+  // Multisampling:
+  std::vector<GLuint> color_render_buffers_;
 };
 
 }  // namespace smk
@@ -0,0 +1,74 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_FRAMEBUFFER_POOL_HPP
+#define SMK_FRAMEBUFFER_POOL_HPP
+
+#include <memory>
+#include <smk/Framebuffer.hpp>
+#include <vector>
+
+namespace smk {
+
+/// A set of reusable Framebuffer for transient off-screen passes (blur, bloom,
+/// glow, ...). Allocating a Framebuffer creates several OpenGL objects and
+/// compiles shaders. The pool hands out Framebuffer matching a given size and
+/// Framebuffer::Option, and recycles them from one frame to the next.
+///
+/// Example:
+/// --------
+///
+/// ~~~cpp
+/// auto pool = smk::FramebufferPool();
+///
+/// window.ExecuteMainLoop([&] {
+///   smk::Framebuffer& pass = pool.Acquire(320, 240);
+///   pass.Clear(smk::Color::Black);
+///   [...]
+///   window.Display();
+///   pool.Recycle();
+/// });
+/// ~~~
+class FramebufferPool {
+ public:
+  FramebufferPool();
+
+  // Return a Framebuffer, unused during the current frame. It stays valid
+  // until the next call to Recycle().
+  Framebuffer& Acquire(int width, int height);
+  Framebuffer& Acquire(int width, int height, const Framebuffer::Option& option);
+
+  // Give back |framebuffer| before the end of the frame, so that it can be
+  // acquired again.
+  void Release(const Framebuffer& framebuffer);
+
+  // Mark the end of a frame. Every Framebuffer become available again.
+  // Framebuffer unused for |max_unused_frames| frames are deleted.
+  void Recycle();
+
+  // Delete every Framebuffer.
+  void Clear();
+
+  void SetMaxUnusedFrames(int max_unused_frames);
+  size_t size() const;
+
+  // Move-only ressource.
+  FramebufferPool(FramebufferPool&&) noexcept = default;
+  FramebufferPool(const FramebufferPool&) = delete;
+  FramebufferPool& operator=(FramebufferPool&&) noexcept = default;
+  FramebufferPool& operator=(const FramebufferPool&) = delete;
+
+ private:
+  struct Entry {
+    std::unique_ptr<Framebuffer> framebuffer;
+    bool in_use = false;
+    int unused_frames = 0;
+  };
+  std::vector<Entry> entries_;
+  int max_unused_frames_ = 3;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_FRAMEBUFFER_POOL_HPP */
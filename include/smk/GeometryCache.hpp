@@ -0,0 +1,99 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_GEOMETRY_CACHE_HPP
+#define SMK_GEOMETRY_CACHE_HPP
+
+#include <array>
+#include <functional>
+#include <list>
+#include <smk/VertexArray.hpp>
+#include <unordered_map>
+
+namespace smk {
+
+/// @brief A cache of VertexArray, indexed by the parameters used to generate
+/// them.
+///
+/// smk::Shape and smk::Sprite use it, so that calling the same generator with
+/// the same parameters returns the same VertexArray, instead of tessellating
+/// and uploading it again.
+///
+/// The cache is bounded by the total number of vertices it holds. The least
+/// recently used entries are evicted first. Evicted VertexArrays stay valid as
+/// long as they are used elsewhere.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// // Tessellated once, then shared.
+/// for(auto& button : buttons) {
+///   button.background = smk::Shape::RoundedRectangle(200, 50, 10);
+/// }
+///
+/// // Limit the GPU memory used by the cache.
+/// smk::GeometryCache::Default().SetMaxSize(100000);
+/// ~~~
+class GeometryCache {
+ public:
+  // The generator identifier, followed by its parameters. The unused ones are
+  // zero. A fixed size avoids allocating a key for every lookup.
+  using Key = std::array<float, 8>;
+
+  // Identify the generator in the keys of the Default() cache.
+  enum class Generator {
+    Circle,
+    RoundedRectangle,
+    Cube,
+    Cylinder,
+    IcoSphere,
+    Plane,
+    Torus,
+    UVSphere,
+    SpriteQuad,
+    Square,
+  };
+
+  GeometryCache();
+  explicit GeometryCache(size_t max_size);
+
+  // The cache used by smk::Shape and smk::Sprite.
+  static GeometryCache& Default();
+
+  // Return the VertexArray associated with |key|. It is built using |build|
+  // when it isn't in the cache.
+  VertexArray Get(const Key& key, const std::function<VertexArray()>& build);
+
+  // The maximum number of vertices held by the cache. Zero disables it.
+  void SetMaxSize(size_t max_size);
+  size_t max_size() const { return max_size_; }
+
+  // The number of vertices held by the cache.
+  size_t size() const { return size_; }
+
+  void Clear();
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    VertexArray vertex_array;
+    std::list<const Key*>::iterator recency;
+  };
+
+  void Evict();
+
+  size_t max_size_;
+  size_t size_ = 0;
+  // The most recently used first. It points to the keys of |entries_|, which
+  // are stable across rehashing.
+  std::list<const Key*> recency_;
+  std::unordered_map<Key, Entry, KeyHash> entries_;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_GEOMETRY_CACHE_HPP */
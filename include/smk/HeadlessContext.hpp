@@ -0,0 +1,67 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_HEADLESS_CONTEXT_HPP
+#define SMK_HEADLESS_CONTEXT_HPP
+
+struct GLFWwindow;
+
+namespace smk {
+
+/// @example headless.cpp
+
+/// @brief An OpenGL context without any visible window. Use it to render
+/// off-screen into a smk::Framebuffer, for instance to produce thumbnails or
+/// to run benchmarks in a continuous integration environment.
+///
+/// Unlike smk::Window, it doesn't print anything and doesn't listen to user
+/// inputs. On a server without display, run it with a virtual display (e.g.
+/// `xvfb-run`). Mesa's software rasterizer can be forced with
+/// `LIBGL_ALWAYS_SOFTWARE=1`.
+///
+/// There is no frame boundary: nothing calls RenderTarget::PollReadPixels()
+/// for you. The futures returned by RenderTarget::ReadPixelsAsync() are
+/// fulfilled only when you call it. Waiting on one without polling blocks
+/// forever:
+/// ~~~cpp
+/// auto future = framebuffer.ReadPixelsAsync({0, 0, 640, 480});
+/// while (future.wait_for(std::chrono::seconds(0)) !=
+///        std::future_status::ready) {
+///   smk::RenderTarget::PollReadPixels();
+/// }
+/// ~~~
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// auto context = smk::HeadlessContext();
+/// auto framebuffer = smk::Framebuffer(640, 480);
+///
+/// framebuffer.Clear(smk::Color::Black);
+/// framebuffer.Draw(sprite);
+/// std::vector<uint8_t> pixels = framebuffer.ReadPixels({0, 0, 640, 480});
+/// ~~~
+class HeadlessContext {
+ public:
+  HeadlessContext();
+  ~HeadlessContext();
+
+  // Make this context the current one for the calling thread.
+  void MakeCurrent();
+
+  GLFWwindow* window() const;
+
+  // Move-only ressource.
+  HeadlessContext(HeadlessContext&&) noexcept;
+  HeadlessContext(const HeadlessContext&) = delete;
+  HeadlessContext& operator=(HeadlessContext&&) noexcept;
+  HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+ private:
+  GLFWwindow* window_ = nullptr;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_HEADLESS_CONTEXT_HPP */
@@ -0,0 +1,69 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_MESH_HPP
+#define SMK_MESH_HPP
+
+#include <smk/OpenGL.hpp>
+#include <smk/Transformable.hpp>
+#include <smk/Vertex.hpp>
+#include <smk/VertexArray.hpp>
+#include <string>
+#include <vector>
+
+namespace smk {
+
+/// @brief An indexed triangle mesh, loaded from a file into the CPU memory.
+///
+/// Supported file formats:
+/// -----------------------
+/// - Wavefront OBJ (.obj): positions, texture coordinates and normals.
+///   Polygons are triangulated.
+/// - glTF 2.0 binary (.glb): the triangles of every mesh primitives, with
+///   their POSITION, NORMAL and TEXCOORD_0 attributes. The node hierarchy
+///   isn't applied.
+/// - Cooked mesh (.smkmesh): the raw vertices and indices, as written by
+///   Mesh::Save. Loading it doesn't involve any parsing.
+///
+/// Vertices sharing the same attributes are merged. When the file doesn't
+/// contain any normal, smooth normals are computed.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// // Parse the OBJ file the first time. Then load the cooked version.
+/// auto mesh = smk::Mesh::LoadCached("teapot.obj", "teapot.smkmesh");
+/// auto teapot = mesh.transformable();
+/// teapot.SetTexture(texture);
+/// window.Draw(teapot);
+/// ~~~
+struct Mesh {
+ public:
+  std::vector<Vertex3D> vertices;
+  std::vector<GLuint> indices;
+
+  // Load a file, depending on its extension. Return an empty Mesh on error.
+  static Mesh Load(const std::string& filename);
+  static Mesh LoadObj(const std::string& filename);
+  static Mesh LoadGlb(const std::string& filename);
+  static Mesh LoadCooked(const std::string& filename);
+
+  // Load |cooked_filename| when it is more recent than |filename|. Otherwise,
+  // load |filename| and save it into |cooked_filename|.
+  static Mesh LoadCached(const std::string& filename,
+                         const std::string& cooked_filename);
+
+  // Write the cooked version of the mesh. Return false on error.
+  bool Save(const std::string& cooked_filename) const;
+
+  bool empty() const { return indices.empty(); }
+
+  // Upload the mesh to the GPU.
+  VertexArray vertex_array() const;
+  Transformable3D transformable() const;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_MESH_HPP */
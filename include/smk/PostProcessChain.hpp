@@ -0,0 +1,103 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_POST_PROCESS_CHAIN_HPP
+#define SMK_POST_PROCESS_CHAIN_HPP
+
+#include <functional>
+#include <glm/glm.hpp>
+#include <smk/BlendMode.hpp>
+#include <smk/Framebuffer.hpp>
+#include <smk/FramebufferPool.hpp>
+#include <smk/Shader.hpp>
+#include <smk/Texture.hpp>
+#include <vector>
+
+namespace smk {
+
+class RenderTarget;
+
+/// @example post_process.cpp
+
+/// A sequence of full-screen passes (blur, bloom, tone mapping, color grading,
+/// ...). Each pass reads the output of the previous one. The intermediate
+/// results are stored into Framebuffer recycled from one frame to the next.
+///
+/// A pass is a fragment shader receiving:
+/// ~~~cpp
+/// in vec2 f_texture_position;  // In [0,1]^2.
+/// uniform sampler2D texture_0; // The output of the previous pass.
+/// uniform vec4 color;          // The color to multiply with.
+/// out vec4 out_color;
+/// ~~~
+///
+/// Example:
+/// --------
+///
+/// ~~~cpp
+/// auto chain = smk::PostProcessChain();
+/// chain.AddGaussianBlur(/*sigma=*/4.F, /*scale=*/0.5F);
+///
+/// window.ExecuteMainLoop([&] {
+///   framebuffer.Clear(smk::Color::Black);
+///   framebuffer.Draw(scene);
+///
+///   window.Clear(smk::Color::Black);
+///   chain.Apply(framebuffer.color_texture(), window);
+///   window.Display();
+/// });
+/// ~~~
+class PostProcessChain {
+ public:
+  using SetUniforms = std::function<void(ShaderProgram& shader_program,
+                                         const Texture& input,
+                                         const glm::vec2& resolution)>;
+
+  PostProcessChain();
+
+  // Add a pass rendered at |scale| times the resolution of the chain's input.
+  // |set_uniforms| is called before drawing the pass, with this resolution.
+  ShaderProgram AddPass(const Shader& fragment_shader, float scale);
+  ShaderProgram AddPass(const Shader& fragment_shader,
+                        float scale,
+                        SetUniforms set_uniforms);
+
+  // Reference effect: a separable gaussian blur, in two passes.
+  void AddGaussianBlur(float sigma, float scale);
+
+  // Run every passes on |input|. The last one is drawn into |output|. An empty
+  // chain copies |input|.
+  void Apply(const Texture& input, RenderTarget& output);
+  void Apply(const Texture& input,
+             RenderTarget& output,
+             const BlendMode& blend_mode);
+
+  // The format of the intermediate Framebuffer. Use a floating point format
+  // for HDR passes like tone mapping.
+  void SetFramebufferOption(const Framebuffer::Option& option);
+
+  size_t size() const;
+
+  // Move-only ressource.
+  PostProcessChain(PostProcessChain&&) noexcept = default;
+  PostProcessChain(const PostProcessChain&) = delete;
+  PostProcessChain& operator=(PostProcessChain&&) noexcept = default;
+  PostProcessChain& operator=(const PostProcessChain&) = delete;
+
+ private:
+  struct Pass {
+    Shader fragment_shader;
+    ShaderProgram shader_program;
+    float scale = 1.F;
+    SetUniforms set_uniforms;
+  };
+  std::vector<Pass> passes_;
+  Shader vertex_shader_;
+  FramebufferPool framebuffer_pool_;
+  Framebuffer::Option framebuffer_option_;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_POST_PROCESS_CHAIN_HPP */
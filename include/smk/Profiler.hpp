@@ -0,0 +1,154 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_PROFILER_HPP
+#define SMK_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <smk/OpenGL.hpp>
+#include <smk/RenderStatistics.hpp>
+#include <string>
+#include <vector>
+
+namespace smk {
+
+class Font;
+class RenderTarget;
+
+/// @example profiler.cpp
+
+/// @brief Measure the CPU and GPU time spent in named scopes of the frames.
+///
+/// The GPU time is measured using timestamp queries. Their results are read
+/// a few frames later, once available, so that the CPU never waits for the
+/// GPU. Every scope also records the RenderStatistics of the work submitted
+/// inside it.
+///
+/// The last completed frames are available through Profiler::frames(). They
+/// can be exported in the Chrome trace format (chrome://tracing or
+/// https://ui.perfetto.dev) or drawn on top of the window.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// smk::Profiler profiler;
+///
+/// window.ExecuteMainLoop([&] {
+///   profiler.BeginFrame();
+///   {
+///     auto scope = profiler.Scope("world");
+///     window.Draw(world);
+///   }
+///   {
+///     auto scope = profiler.Scope("interface");
+///     window.Draw(interface);
+///   }
+///   profiler.DrawOverlay(window);
+///   profiler.EndFrame();
+///   window.Display();
+/// });
+///
+/// profiler.SaveChromeTrace("trace.json");
+/// ~~~
+class Profiler {
+ public:
+  struct ScopeResult {
+    std::string name;
+    int depth = 0;            // The number of enclosing scopes.
+    double cpu_begin = 0.0;   // In seconds, since the start of the profiler.
+    double cpu_duration = 0.0;
+    double gpu_begin = 0.0;   // In seconds, since the start of the frame.
+    double gpu_duration = -1.0;  // In seconds. Negative when unavailable.
+    RenderStatistics statistics;
+  };
+
+  struct Frame {
+    uint64_t index = 0;
+    double cpu_begin = 0.0;
+    double cpu_duration = 0.0;
+    double gpu_duration = -1.0;
+    RenderStatistics statistics;
+    std::vector<ScopeResult> scopes;  // In the order they began.
+  };
+
+  // Close the scope it was returned by, when destroyed.
+  class ScopeGuard {
+   public:
+    explicit ScopeGuard(Profiler* profiler) : profiler_(profiler) {}
+    ~ScopeGuard();
+    ScopeGuard(ScopeGuard&& other) noexcept;
+    ScopeGuard(const ScopeGuard&) = delete;
+    ScopeGuard& operator=(ScopeGuard&&) = delete;
+    ScopeGuard& operator=(const ScopeGuard&) = delete;
+
+   private:
+    Profiler* profiler_;
+  };
+
+  Profiler();
+  explicit Profiler(size_t history);
+  ~Profiler();
+
+  // Disabled profilers don't issue any query.
+  void SetEnabled(bool enabled);
+  bool enabled() const { return enabled_; }
+
+  void BeginFrame();
+  void EndFrame();
+
+  void BeginScope(const std::string& name);
+  void EndScope();
+  ScopeGuard Scope(const std::string& name);
+
+  // The last completed frames, oldest first.
+  const std::deque<Frame>& frames() const { return frames_; }
+
+  // Export the completed frames in the Chrome trace event format.
+  std::string ChromeTrace() const;
+  bool SaveChromeTrace(const std::string& filename) const;
+
+  // Draw the scopes of the last completed frame, as bars whose length is
+  // their duration. The labels are drawn when a font is provided.
+  void DrawOverlay(RenderTarget& target);
+  void DrawOverlay(RenderTarget& target, Font& font);
+
+  // Move-only class.
+  Profiler(Profiler&&) noexcept = default;
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(Profiler&&) noexcept = default;
+  Profiler& operator=(const Profiler&) = delete;
+
+ private:
+  // A frame whose GPU timestamps might not be available yet.
+  struct PendingFrame {
+    Frame frame;
+    GLuint frame_queries[2] = {0, 0};
+    std::vector<GLuint> scope_queries;  // Two per scope.
+  };
+
+  double Now() const;
+  GLuint AcquireQuery();
+  void Timestamp(GLuint query);
+  void Collect(bool wait);
+  void Overlay(RenderTarget& target, Font* font);
+
+  bool enabled_ = true;
+  size_t history_ = 0;
+  uint64_t frame_index_ = 0;
+  std::chrono::steady_clock::time_point start_;
+
+  bool in_frame_ = false;
+  PendingFrame current_;
+  std::vector<size_t> open_scopes_;
+  std::deque<PendingFrame> pending_;
+  std::deque<Frame> frames_;
+  std::vector<GLuint> free_queries_;
+  std::vector<GLuint> all_queries_;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_PROFILER_HPP */
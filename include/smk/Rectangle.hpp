@@ -17,8 +17,29 @@ struct Rectangle {
 
   float width() const { return right - left; }
   float height() const { return bottom - top; }
+  float area() const { return width() * height(); }
+
+  // Whether the two rectangles overlap. Touching edges count as overlapping.
+  bool Intersects(const Rectangle& other) const {
+    return right >= other.left && left <= other.right &&  //
+           bottom >= other.top && top <= other.bottom;
+  }
+
+  // The smallest rectangle containing both rectangles.
+  Rectangle Union(const Rectangle& other) const {
+    return {
+        glm::min(left, other.left),
+        glm::min(top, other.top),
+        glm::max(right, other.right),
+        glm::max(bottom, other.bottom),
+    };
+  }
 };
 
+// The box bounding |box| once transformed by |transformation|.
+Rectangle TransformBoundingBox(const Rectangle& box,
+                               const glm::mat4& transformation);
+
 }  // namespace smk
 
 #endif /* end of include guard: SMK_RECTANGLE */
@@ -7,6 +7,7 @@
 
 #include <glm/glm.hpp>
 #include <smk/BlendMode.hpp>
+#include <smk/OpenGL.hpp>
 #include <smk/Shader.hpp>
 #include <smk/Texture.hpp>
 #include <smk/VertexArray.hpp>
@@ -21,6 +22,9 @@ struct RenderState {
   glm::mat4 view = glm::mat4(1.f);          ///< The "view" transformation.
   glm::vec4 color = glm::vec4(0.f);         ///< The masking color.
   BlendMode blend_mode = BlendMode::Alpha;  ///< The OpenGL BlendMode
+  bool depth_test = false;                  ///< Test against the depth buffer.
+  bool depth_write = true;                  ///< Write into the depth buffer.
+  GLenum cull_face = GL_NONE;               ///< GL_BACK, GL_FRONT or GL_NONE.
 };
 
 }  // namespace smk
@@ -0,0 +1,57 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_RENDER_STATISTICS_HPP
+#define SMK_RENDER_STATISTICS_HPP
+
+#include <cstdint>
+
+namespace smk {
+
+/// @brief Counters of the work submitted to the GPU.
+///
+/// The counters are cumulated since the start of the program. Subtract two
+/// snapshots to get the work done in between. RenderTarget::statistics()
+/// returns the ones of the last frame.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// auto before = smk::RenderStatistics::Total();
+/// window.Draw(scene);
+/// auto work = smk::RenderStatistics::Total() - before;
+/// std::cout << work.draw_calls << " draw calls" << std::endl;
+/// ~~~
+struct RenderStatistics {
+  // Submission:
+  uint64_t draw_calls = 0;
+  uint64_t vertices = 0;  // The number of indices, for indexed draws.
+  uint64_t triangles = 0;
+
+  // Vertex array, shader, texture, color, blending, depth or culling changes.
+  uint64_t state_changes = 0;
+  uint64_t shader_switches = 0;
+  uint64_t texture_binds = 0;
+  uint64_t blend_changes = 0;
+  uint64_t uniform_uploads = 0;
+
+  // Resources:
+  uint64_t vertex_array_creations = 0;
+  uint64_t vertex_array_deletions = 0;
+  uint64_t buffer_creations = 0;  // Vertex and index buffers.
+  uint64_t buffer_deletions = 0;
+  uint64_t texture_creations = 0;
+  uint64_t texture_deletions = 0;
+
+  // Bytes uploaded into vertex buffers, index buffers and textures.
+  uint64_t bytes_uploaded = 0;
+
+  RenderStatistics operator-(const RenderStatistics& other) const;
+
+  static const RenderStatistics& Total();
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_RENDER_STATISTICS_HPP */
@@ -5,12 +5,18 @@
 #ifndef SMK_RENDER_TARGET_HPP
 #define SMK_RENDER_TARGET_HPP
 
+#include <cstdint>
+#include <future>
 #include <glm/glm.hpp>
 #include <memory>
+#include <smk/Rectangle.hpp>
+#include <smk/RenderStatistics.hpp>
 #include <smk/RenderState.hpp>
 #include <smk/Shader.hpp>
 #include <smk/VertexArray.hpp>
 #include <smk/View.hpp>
+#include <utility>
+#include <vector>
 
 namespace smk {
 
@@ -38,26 +44,73 @@ class RenderTarget {
   void SetView(const glm::mat4& mat);
   const View& view() const;
 
+  // Skip drawing objects outside of the View. This is enabled by default, and
+  // only effective when the View is set using a smk::View.
+  void SetCulling(bool culling);
+  bool IsVisible(const Rectangle& bounding_box,
+                 const glm::mat4& transformation) const;
+
+  // The pixels covered by an object, in a 2D View.
+  Rectangle PixelBounds(const Rectangle& bounding_box,
+                        const glm::mat4& transformation) const;
+
+  // Restrict the drawing to a rectangle, in pixels. Used to redraw only the
+  // damaged regions, see smk::DamageTracker.
+  void SetScissor(const Rectangle& rectangle);
+  void ResetScissor();
+
   // 2. Set a shader to render elements.
   void SetShaderProgram(ShaderProgram& shader_program);
   ShaderProgram& shader_program_2d();
   ShaderProgram& shader_program_3d();
 
+  // 3D rendering: depth test and face culling of the next drawables. Both are
+  // disabled by default.
+  void SetDepthTest(bool depth_test);
+  void SetCullFace(GLenum cull_face);
+
+  // Queue the draws in between, and submit them sorted by depth: the opaque
+  // ones (BlendMode::Replace) from front to back, then the others from back to
+  // front, without writing the depth.
+  void BeginDepthSorting();
+  void EndDepthSorting();
+
   // 3. Draw some stuff.
   virtual void Draw(const Drawable& drawable);
   virtual void Draw(RenderState& state);
+  void DrawFullScreen(RenderState& state);
 
   // Surface dimensions:
   glm::vec2 dimensions() const;
   int width() const;
   int height() const;
 
+  // 4. Read pixels back. RGBA, 8 bits per channel, rows from top to bottom.
+  // Multisampled Framebuffer must be resolved first.
+  std::vector<uint8_t> ReadPixels(const Rectangle& rectangle);
+  std::future<std::vector<uint8_t>> ReadPixelsAsync(const Rectangle& rectangle);
+
+  // Fulfill the ReadPixelsAsync requests whose pixels have arrived. This is
+  // called by Window::Display(). Without a Window, call it yourself.
+  static void PollReadPixels();
+
+  // Counters of the work submitted during the last frame. A frame ends at every
+  // Window::Display(), or EndFrameStatistics() for other targets. The counters
+  // are global to the context: the work submitted to other RenderTargets
+  // during the frame is included.
+  const RenderStatistics& statistics() const;
+  RenderStatistics current_statistics() const;  // So far in this frame.
+  void EndFrameStatistics();
+
   // Bind the OpenGL RenderFrame. This function is useless, because it is called
   // automatically for you. Use this only when you use direct OpenGL call.
   static void Bind(RenderTarget* target);
 
  protected:
   void InitRenderTarget();
+  void Submit(RenderState& state);
+  void ApplyScissor() const;
+  Rectangle ViewToPixels(const Rectangle& rectangle) const;
 
   int width_ = 0;
   int height_ = 0;
@@ -65,6 +118,19 @@ class RenderTarget {
   // View:
   glm::mat4 projection_matrix_ = glm::mat4(1);
   smk::View view_;
+  bool view_is_2d_ = false;
+  bool culling_ = true;
+
+  // Scissor, in pixels:
+  bool scissor_test_ = false;
+  Rectangle scissor_ = {0.F, 0.F, 0.F, 0.F};
+
+  // 3D:
+  bool depth_test_ = false;
+  GLenum cull_face_ = GL_NONE;
+  bool depth_sorting_ = false;
+  std::vector<RenderState> sorted_states_;
+  std::vector<std::pair<float, size_t>> sorted_order_;
 
   // Shaders:
   Shader vertex_shader_2d_;
@@ -79,6 +145,10 @@ class RenderTarget {
   ShaderProgram shader_program_;
 
   GLuint frame_buffer_ = 0;
+
+  // Statistics:
+  RenderStatistics statistics_;
+  RenderStatistics frame_begin_statistics_;
 };
 
 }  // namespace smk
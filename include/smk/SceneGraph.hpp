@@ -0,0 +1,140 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_SCENE_GRAPH_HPP
+#define SMK_SCENE_GRAPH_HPP
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <smk/Drawable.hpp>
+#include <smk/Transformable.hpp>
+#include <vector>
+
+namespace smk {
+
+class Text;
+
+/// @example scene_graph.cpp
+
+/// @brief A hierarchy of 2D objects. Each node is a smk::Transformable, whose
+/// transformation is relative to its parent. Moving, rotating or scaling a node
+/// affects its whole subtree.
+///
+/// A node without any VertexArray is a group. It isn't drawn, but it still
+/// transforms its children.
+///
+/// The world transformations are computed by SceneGraph::Update(). The nodes
+/// are stored in a flattened array, in depth-first order, so that a parent is
+/// always updated before its children in a single linear pass. Only the
+/// subtrees of the modified nodes are recomputed.
+///
+/// Nodes are drawn in depth-first order: a parent is drawn below its children,
+/// and siblings in the order they were added.
+///
+/// The nodes are stored by value, as smk::Transformable. Subclasses adding
+/// their own state or drawing code are sliced. This is why smk::Text is
+/// rejected at compile time.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// auto scene = smk::SceneGraph();
+/// auto panel = scene.Add(smk::Transformable());
+/// for(auto& position : positions) {
+///   button.SetPosition(position);
+///   scene.Add(button, panel);
+/// }
+///
+/// [...]
+///
+/// scene.SetPosition(panel, {100.f, 50.f}); // Move every buttons.
+/// window.Draw(scene);
+/// ~~~
+class SceneGraph : public Drawable {
+ public:
+  using Handle = uint32_t;
+
+  SceneGraph();
+
+  // The root node, always present. Its transformation applies to every node.
+  Handle root() const { return 0; }
+
+  // Removed or unknown handles are ignored by the modifiers. The accessors
+  // return empty values for them.
+  Handle Add(const Transformable& object);
+  Handle Add(const Transformable& object, Handle parent);
+  Handle Add(const Text& text) = delete;                 // Would be sliced.
+  Handle Add(const Text& text, Handle parent) = delete;  // Would be sliced.
+  void Remove(Handle handle);
+  void SetParent(Handle handle, Handle parent);
+  Handle parent(Handle handle) const;
+  const std::vector<Handle>& children(Handle handle) const;
+
+  const Transformable& Get(Handle handle) const;
+
+  // Modify a node. Its subtree is marked dirty.
+  void Set(Handle handle, const Transformable& object);
+  void Set(Handle handle, const Text& text) = delete;  // Would be sliced.
+  void SetPosition(Handle handle, const glm::vec2& position);
+  void Move(Handle handle, const glm::vec2& move);
+  void SetRotation(Handle handle, float rotation);
+  void Rotate(Handle handle, float rotation);
+  void SetScale(Handle handle, const glm::vec2& scale);
+  void SetCenter(Handle handle, const glm::vec2& center);
+
+  // Hide a subtree. Hidden subtrees are skipped while drawing.
+  void SetVisible(Handle handle, bool visible);
+  bool visible(Handle handle) const;
+
+  // The transformation of a node, relative to the scene.
+  const glm::mat3x2& world(Handle handle) const;
+  glm::vec2 ToWorld(Handle handle, const glm::vec2& local) const;
+
+  // Recompute the world transformation of the dirty subtrees. Called
+  // automatically by SceneGraph::Draw and SceneGraph::world.
+  void Update() const;
+
+  size_t size() const;
+
+  // Drawable override.
+  void Draw(RenderTarget& target, RenderState state) const override;
+
+  // Movable-copyable class.
+  SceneGraph(SceneGraph&&) noexcept = default;
+  SceneGraph(const SceneGraph&) = default;
+  SceneGraph& operator=(SceneGraph&&) noexcept = default;
+  SceneGraph& operator=(const SceneGraph&) = default;
+
+ private:
+  struct Node {
+    Transformable transformable;
+    Handle parent = 0;
+    std::vector<Handle> children;
+    bool alive = false;
+    bool visible = true;
+  };
+
+  bool IsAlive(Handle handle) const;
+  void Invalidate(Handle handle);
+  void Flatten() const;
+
+  std::vector<Node> nodes_;
+  std::vector<Handle> free_handles_;
+
+  // The flattened hierarchy, in depth-first order. Rebuilt only when the
+  // hierarchy changes. Indexed by slot, except |slot_|, indexed by handle.
+  mutable bool flattened_ = false;
+  mutable bool dirty_ = false;
+  mutable std::vector<Handle> handle_;
+  mutable std::vector<uint32_t> parent_slot_;
+  mutable std::vector<uint32_t> subtree_size_;
+  mutable std::vector<uint8_t> dirty_slot_;
+  mutable std::vector<glm::mat3x2> local_;
+  mutable std::vector<glm::mat3x2> world_;
+  mutable std::vector<uint32_t> slot_;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_SCENE_GRAPH_HPP */
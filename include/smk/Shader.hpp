@@ -162,6 +162,7 @@ class ShaderProgram {
 
   // affect uniform
   void SetUniform(const std::string& name, float x, float y, float z);
+  void SetUniform(const std::string& name, const glm::vec2& v);
   void SetUniform(const std::string& name, const glm::vec3& v);
   void SetUniform(const std::string& name, const glm::vec4& v);
   void SetUniform(const std::string& name, const glm::mat4& m);
@@ -6,6 +6,7 @@
 #define SMK_SHAPE_HPP
 
 #include <glm/glm.hpp>
+#include <smk/Stroker.hpp>
 #include <smk/Transformable.hpp>
 #include <smk/VertexArray.hpp>
 
@@ -17,6 +18,18 @@
 namespace smk {
 
 /// A collection of static function to build simple shape.
+///
+/// The shapes are stored into the smk::GeometryCache. Building the same shape
+/// twice returns the same VertexArray. Lines and paths are the exception: they
+/// are defined by their coordinates, which are rarely reused. The 3D shapes are indexed: the vertices
+/// are shared in between the triangles.
+///
+/// Circles and rounded rectangles can be tessellated according to their size
+/// on screen, given a tolerance in pixels:
+/// ~~~cpp
+/// float view_scale = window.width() / (view.Right() - view.Left());
+/// auto circle = smk::Shape::Circle(radius, 0.5f, view_scale);
+/// ~~~
 class Shape {
  public:
   static Transformable FromVertexArray(VertexArray vertex_array);
@@ -26,14 +39,34 @@ class Shape {
   static Transformable Square();
   static Transformable Circle(float radius);
   static Transformable Circle(float radius, int subdivisions);
+  static Transformable Circle(float radius, float tolerance, float view_scale);
   static Transformable Path(const std::vector<glm::vec2>& points,
                             float thickness);
+  static Transformable Path(const std::vector<glm::vec2>& points,
+                            const Stroker::Style& style);
   static Transformable RoundedRectangle(float width,
                                         float height,
                                         float radius);
+  static Transformable RoundedRectangle(float width,
+                                        float height,
+                                        float radius,
+                                        int corner_subdivisions);
+  static Transformable RoundedRectangle(float width,
+                                        float height,
+                                        float radius,
+                                        float tolerance,
+                                        float view_scale);
   static Transformable3D Cube();
+  static Transformable3D Cylinder(int subdivisions);
   static Transformable3D IcoSphere(int iteration);
   static Transformable3D Plane();
+  static Transformable3D Torus(float tube_radius,
+                               int major_subdivisions,
+                               int minor_subdivisions);
+  static Transformable3D UVSphere(int slices, int stacks);
+  static int CircleSubdivisions(float radius,
+                                float tolerance,
+                                float view_scale);
   static std::vector<glm::vec2> Bezier(const std::vector<glm::vec2>& point,
                                        size_t subdivision);
 };
@@ -0,0 +1,105 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_SHAPE_BATCH_HPP
+#define SMK_SHAPE_BATCH_HPP
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <smk/BlendMode.hpp>
+#include <smk/Drawable.hpp>
+#include <smk/Vertex.hpp>
+#include <smk/VertexArray.hpp>
+#include <vector>
+
+namespace smk {
+
+/// @example shape_batch.cpp
+
+/// @brief A set of circles, rounded rectangles and lines, drawn using a single
+/// draw call.
+///
+/// Unlike smk::Shape, the shapes aren't tessellated. Each one is a single quad,
+/// whose pixels evaluate the signed distance to the shape. This gives
+/// antialiased edges without multisampling, and borders and corner radii of
+/// any size for the same cost.
+///
+/// The shapes are drawn in the order they were added.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// auto window = smk::Window(640, 480, "title", /*samples=*/0);
+/// auto batch = smk::ShapeBatch();
+///
+/// size_t button = batch.AddRoundedRectangle({320, 240}, {200, 50}, 10);
+/// batch.SetColor(button, smk::Color::Blue);
+/// batch.SetBorder(button, 2, smk::Color::White);
+///
+/// batch.AddCircle({100, 100}, 20);
+/// batch.AddLine({0, 0}, {640, 480}, 3);
+///
+/// window.Draw(batch);
+/// ~~~
+class ShapeBatch : public Drawable {
+ public:
+  ShapeBatch();
+
+  // Add a shape. Return its index.
+  size_t AddCircle(const glm::vec2& center, float radius);
+  size_t AddRoundedRectangle(const glm::vec2& center,
+                             const glm::vec2& size,
+                             float radius);
+  size_t AddLine(const glm::vec2& a, const glm::vec2& b, float thickness);
+
+  // Modify a shape.
+  void SetColor(size_t index, const glm::vec4& color);
+  void SetBorder(size_t index, float width, const glm::vec4& color);
+  void Move(size_t index, const glm::vec2& move);
+
+  void Clear();
+  size_t size() const;
+
+  void SetBlendMode(const BlendMode& blend_mode);
+  const BlendMode& blend_mode() const { return blend_mode_; }
+
+  // Drawable override.
+  void Draw(RenderTarget& target, RenderState state) const override;
+
+  // Movable-copyable class. Copies don't share their GPU buffer.
+  ShapeBatch(ShapeBatch&&) noexcept = default;
+  ShapeBatch(const ShapeBatch&);
+  ShapeBatch& operator=(ShapeBatch&&) noexcept = default;
+  ShapeBatch& operator=(const ShapeBatch&);
+
+ private:
+  // Every shape is a rounded box, possibly rotated.
+  struct Primitive {
+    glm::vec2 center;
+    glm::vec2 axis;  // The direction of the local X axis.
+    glm::vec2 half_size;
+    float radius = 0.f;
+    float border = 0.f;
+    uint32_t color = 0xFFFFFFFF;
+    uint32_t border_color = 0xFFFFFFFF;
+  };
+
+  size_t Add(const Primitive& primitive);
+  void GenerateVertices(float padding, Rectangle* bounding_box) const;
+
+  std::vector<Primitive> primitives_;
+  BlendMode blend_mode_ = BlendMode::Alpha;
+
+  // The generated vertices, 4 per shape. They are only regenerated after a
+  // modification, or when the size of the pixels changes.
+  mutable std::vector<Vertex2DShape> vertices_;
+  mutable VertexArray vertex_array_;
+  mutable size_t vertex_array_capacity_ = 0;
+  mutable bool modified_ = true;
+  mutable float padding_ = 0.f;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_SHAPE_BATCH_HPP */
@@ -0,0 +1,125 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_SPATIAL_SCENE_HPP
+#define SMK_SPATIAL_SCENE_HPP
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <smk/Drawable.hpp>
+#include <smk/Rectangle.hpp>
+#include <smk/Transformable.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace smk {
+
+class Text;
+
+/// @example spatial_scene.cpp
+
+/// @brief A large set of 2D objects (smk::Sprite, smk::Shape, ...) indexed by
+/// position. Drawing it only draws the objects intersecting the View, and
+/// costs time proportional to the visible area, not to the number of objects.
+///
+/// The objects are stored into a grid of square cells (a spatial hash). Each
+/// object is registered in the cells its bounding box overlaps. Use the
+/// SpatialScene's functions to move the objects, so that the grid is updated.
+///
+/// Objects are drawn in the order they were added.
+///
+/// The objects are stored by value, as smk::Transformable. Subclasses adding
+/// their own state or drawing code are sliced. This is why smk::Text is
+/// rejected at compile time.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// auto scene = smk::SpatialScene();
+/// for(auto& position : positions) {
+///   sprite.SetPosition(position);
+///   scene.Add(sprite);
+/// }
+///
+/// [...]
+///
+/// window.Draw(scene);
+///
+/// // Objects under the mouse, topmost first.
+/// auto hits = scene.Query(window.input().cursor());
+/// ~~~
+class SpatialScene : public Drawable {
+ public:
+  using Handle = uint32_t;
+
+  SpatialScene();
+  explicit SpatialScene(float cell_size);
+
+  Handle Add(const Transformable& object);
+  Handle Add(const Text& text) = delete;  // Would be sliced.
+  void Remove(Handle handle);
+  const Transformable& Get(Handle handle) const;
+
+  // Modify an object. The index is updated incrementally.
+  void Set(Handle handle, const Transformable& object);
+  void Set(Handle handle, const Text& text) = delete;  // Would be sliced.
+  void SetPosition(Handle handle, const glm::vec2& position);
+  void Move(Handle handle, const glm::vec2& move);
+
+  // Picking. Return the objects whose bounding box intersects the area, from
+  // the topmost to the bottommost.
+  std::vector<Handle> Query(const Rectangle& area) const;
+  std::vector<Handle> Query(const glm::vec2& point) const;
+
+  size_t size() const;
+
+  // Drawable override.
+  void Draw(RenderTarget& target, RenderState state) const override;
+
+  // Movable-copyable class.
+  SpatialScene(SpatialScene&&) noexcept = default;
+  SpatialScene(const SpatialScene&) = default;
+  SpatialScene& operator=(SpatialScene&&) noexcept = default;
+  SpatialScene& operator=(const SpatialScene&) = default;
+
+ private:
+  struct CellRange {
+    int left = 0;
+    int top = 0;
+    int right = -1;
+    int bottom = -1;
+    bool operator==(const CellRange& other) const;
+  };
+
+  struct Object {
+    Transformable transformable;
+    Rectangle bounding_box = {0.f, 0.f, 0.f, 0.f};
+    CellRange cells;
+    uint64_t sequence = 0;  // Insertion order.
+    bool alive = false;
+  };
+
+  bool IsAlive(Handle handle) const;
+  void SortByInsertion(std::vector<Handle>* handles) const;
+
+  CellRange ComputeCellRange(const Rectangle& area) const;
+  void Insert(Handle handle);
+  void Erase(Handle handle);
+  void Update(Handle handle);
+  void Collect(const Rectangle& area, std::vector<Handle>* out) const;
+
+  float cell_size_ = 256.f;
+  std::vector<Object> objects_;
+  std::vector<Handle> free_handles_;
+  uint64_t next_sequence_ = 0;
+  std::unordered_map<int64_t, std::vector<Handle>> cells_;
+
+  // Used to deduplicate the objects overlapping several cells during a query.
+  mutable std::vector<uint32_t> query_stamps_;
+  mutable uint32_t query_stamp_ = 0;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_SPATIAL_SCENE_HPP */
@@ -0,0 +1,116 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_SPRITE_BATCH_HPP
+#define SMK_SPRITE_BATCH_HPP
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <smk/BlendMode.hpp>
+#include <smk/Drawable.hpp>
+#include <smk/Rectangle.hpp>
+#include <smk/Texture.hpp>
+#include <smk/Vertex.hpp>
+#include <smk/VertexArray.hpp>
+#include <vector>
+
+namespace smk {
+
+/// @example sprite_batch.cpp
+
+/// @brief A large number of sprites sharing the same texture, drawn using a
+/// single draw call.
+///
+/// Unlike smk::Sprite, a sprite in a SpriteBatch isn't an object, it is an
+/// index. Its properties are stored in separate arrays (structure of arrays),
+/// so that updating and drawing them are tight loops over contiguous memory.
+/// The vertices of every sprites are generated in a single pass, into a single
+/// dynamic GPU buffer.
+///
+/// The sprites are drawn in index order, using the batch's own shader. The
+/// transformations follows smk::Transformable's conventions.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// auto batch = smk::SpriteBatch(texture);
+/// for(int i = 0; i<1000000; ++i)
+///   batch.Add(positions[i]);
+///
+/// [...]
+///
+/// glm::vec2* positions = batch.positions();
+/// for(size_t i = 0; i<batch.size(); ++i)
+///   positions[i] += speed[i];
+///
+/// window.Draw(batch);
+/// ~~~
+class SpriteBatch : public Drawable {
+ public:
+  SpriteBatch();
+  explicit SpriteBatch(const Texture& texture);
+
+  // Add a sprite, displaying the whole texture or a part of it.
+  size_t Add(const glm::vec2& position);
+  size_t Add(const glm::vec2& position, const Rectangle& texture_rectangle);
+
+  // Remove a sprite. The last one takes its index.
+  void Remove(size_t index);
+  void Clear();
+  void Reserve(size_t capacity);
+  size_t size() const;
+
+  // Modify a sprite. @see smk::Transformable.
+  void SetPosition(size_t index, const glm::vec2& position);
+  void SetRotation(size_t index, float rotation);
+  void SetScale(size_t index, const glm::vec2& scale);
+  void SetCenter(size_t index, const glm::vec2& center);
+  void SetColor(size_t index, const glm::vec4& color);
+  void SetTextureRectangle(size_t index, const Rectangle& texture_rectangle);
+
+  // Direct access to the positions, for bulk updates. There are size() of
+  // them.
+  glm::vec2* positions() { return positions_.data(); }
+  const glm::vec2* positions() const { return positions_.data(); }
+
+  // Properties shared by every sprites.
+  void SetTexture(const Texture& texture);
+  const Texture& texture() const { return texture_; }
+  void SetBlendMode(const BlendMode& blend_mode);
+  const BlendMode& blend_mode() const { return blend_mode_; }
+
+  // Drawable override.
+  void Draw(RenderTarget& target, RenderState state) const override;
+
+  // Movable-copyable class.
+  SpriteBatch(SpriteBatch&&) noexcept = default;
+  SpriteBatch(const SpriteBatch&) = default;
+  SpriteBatch& operator=(SpriteBatch&&) noexcept = default;
+  SpriteBatch& operator=(const SpriteBatch&) = default;
+
+ private:
+  void GenerateVertices(Rectangle* bounding_box) const;
+
+  Texture texture_;
+  BlendMode blend_mode_ = BlendMode::Alpha;
+
+  // Structure of arrays. One element per sprite.
+  std::vector<glm::vec2> positions_;
+  std::vector<glm::vec2> rotations_;  // (cos, sin) of the angle.
+  std::vector<glm::vec2> scales_;
+  std::vector<glm::vec2> centers_;
+  std::vector<glm::vec2> sizes_;
+  std::vector<glm::vec4> texture_coordinates_;  // (left, top, right, bottom)
+  std::vector<uint32_t> colors_;
+
+  // The generated vertices, 4 per sprite, and their GPU buffer. The indices are
+  // only regenerated when the capacity grows.
+  mutable std::vector<Vertex2DColor> vertices_;
+  mutable VertexArray vertex_array_;
+  mutable size_t vertex_array_capacity_ = 0;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_SPRITE_BATCH_HPP */
@@ -0,0 +1,112 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#ifndef SMK_STROKER_HPP
+#define SMK_STROKER_HPP
+
+#include <glm/glm.hpp>
+#include <smk/OpenGL.hpp>
+#include <smk/Vertex.hpp>
+#include <smk/VertexArray.hpp>
+#include <vector>
+
+namespace smk {
+
+/// @brief Convert polylines into triangles, drawing a line of a given
+/// thickness along them.
+///
+/// Several polylines can be added. They are accumulated into the same indexed
+/// triangle list, so that they can be drawn using a single VertexArray. The
+/// buffers are reused after Stroker::Clear, so stroking doesn't allocate
+/// memory once they are large enough.
+///
+/// Consecutive duplicated points are ignored. Each segment is a rectangle,
+/// the joins fill the gap on the outer side of the turns.
+///
+/// Example:
+/// --------
+/// ~~~cpp
+/// auto stroker = smk::Stroker();
+/// smk::Stroker::Style style;
+/// style.thickness = 3.f;
+/// style.join = smk::Stroker::Join::Round;
+/// style.cap = smk::Stroker::Cap::Round;
+/// stroker.SetStyle(style);
+///
+/// for(const auto& track : tracks)
+///   stroker.Add(track);
+///
+/// auto tracks_drawable = smk::Shape::FromVertexArray(stroker.vertex_array());
+/// ~~~
+class Stroker {
+ public:
+  /// How two consecutive segments are connected.
+  enum class Join {
+    Miter,  ///< Extend the outer edges until they meet.
+    Bevel,  ///< Connect the outer corners with a straight line.
+    Round,  ///< Connect the outer corners with an arc.
+  };
+
+  /// How the ends of the polylines are drawn.
+  enum class Cap {
+    Butt,    ///< Stop exactly at the end.
+    Square,  ///< Extend by half of the thickness.
+    Round,   ///< Add a half disk.
+  };
+
+  struct Style {
+    float thickness = 1.f;
+    Join join = Join::Miter;
+    Cap cap = Cap::Butt;
+    // The maximal ratio in between the length of a miter and half of the
+    // thickness. Sharper joins are beveled.
+    float miter_limit = 4.f;
+    // The maximal distance in between the round joins and caps and the perfect
+    // arcs.
+    float tolerance = 0.25f;
+  };
+
+  Stroker();
+  explicit Stroker(const Style& style);
+
+  void SetStyle(const Style& style);
+  const Style& style() const { return style_; }
+
+  // Append the stroke of a polyline.
+  void Add(const std::vector<glm::vec2>& points);
+  void Add(const glm::vec2* points, size_t size);
+
+  // Remove the triangles. The memory is kept for future use.
+  void Clear();
+
+  // The triangles of every polylines added.
+  const std::vector<Vertex2D>& vertices() const { return vertices_; }
+  const std::vector<GLuint>& indices() const { return indices_; }
+  VertexArray vertex_array() const;
+
+ private:
+  void AddSegment(const glm::vec2& a, const glm::vec2& b, const glm::vec2& n);
+  void AddJoin(const glm::vec2& point,
+               const glm::vec2& direction_in,
+               const glm::vec2& direction_out);
+  void AddCap(const glm::vec2& point, const glm::vec2& direction);
+  void AddDot(const glm::vec2& point);
+  void AddArc(const glm::vec2& center, const glm::vec2& start, float angle);
+  void AddQuad(const glm::vec2& a,
+               const glm::vec2& b,
+               const glm::vec2& c,
+               const glm::vec2& d);
+  GLuint AddVertex(const glm::vec2& position);
+
+  Style style_;
+  float half_thickness_ = 0.5f;
+  float arc_step_ = 0.5f;
+
+  std::vector<Vertex2D> vertices_;
+  std::vector<GLuint> indices_;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_STROKER_HPP */
@@ -11,8 +11,9 @@
 namespace smk {
 
 /// A texture loaded from a file into the GPU. This class support the move and
-/// copy operators. Its underlying GPU texture is refcounted and released when
-/// then last smk::Texture is deleted.
+/// copy operators. Its underlying GPU texture is refcounted and deleted when
+/// the last smk::Texture using it is deleted. The textures imported from an
+/// OpenGL identifier are the exception: they still belong to the caller.
 ///
 /// Example:
 /// --------
@@ -53,7 +54,7 @@ struct Texture {
   Texture(const std::string& filename, const Option& option);
   Texture(const uint8_t* data, int width, int height);
   Texture(const uint8_t* data, int width, int height, const Option& option);
-  Texture(GLuint id, int width, int height);
+  Texture(GLuint id, int width, int height);  // Doesn't own |id|.
   ~Texture();
 
   void Bind(GLuint active_texture = GL_TEXTURE0) const;
@@ -83,6 +84,9 @@ struct Texture {
   // Used to support copy. Nullptr as long as this class is not copied.
   // Otherwise an integer counting how many instances shares this resource.
   mutable int* ref_count_ = nullptr;
+
+  // False for the imported textures, which are never deleted by smk.
+  bool owned_ = true;
 };
 
 }  // namespace smk
@@ -49,6 +49,11 @@ class TransformableBase : public Drawable {
   TransformableBase& operator=(TransformableBase&&) noexcept = default;
   TransformableBase& operator=(const TransformableBase&) = default;
 
+ protected:
+  // Multiply |view| by the transformation. Override it when the transformation
+  // has a cheaper representation than a full 4x4 matrix.
+  virtual void ApplyTransformation(glm::mat4* view) const;
+
  private:
   glm::vec4 color_ = {1.0, 1.0, 1.0, 1.0};
   Texture texture_;
@@ -86,6 +91,16 @@ class Transformable : public TransformableBase {
   void SetScaleX(float scale_x);
   void SetScaleY(float scale_y);
 
+  // Accessors.
+  float rotation() const { return rotation_; }
+  const glm::vec2& center() const { return center_; }
+  const glm::vec2& position() const { return position_; }
+  const glm::vec2& scale() const { return scale_; }
+
+  // The 2D affine transformation, as a 3x2 matrix. Its first two columns are
+  // the images of the X and Y axis, the last one is the translation.
+  const glm::mat3x2& affine() const;
+
   // Transformable override;
   glm::mat4 transformation() const override;
 
@@ -96,11 +111,20 @@ class Transformable : public TransformableBase {
   Transformable& operator=(Transformable&&) = default;
   Transformable& operator=(const Transformable&) = default;
 
+ protected:
+  // TransformableBase override:
+  void ApplyTransformation(glm::mat4* view) const override;
+
  private:
   float rotation_ = 0.f;
   glm::vec2 center_ = {0.f, 0.f};
   glm::vec2 position_ = {0.f, 0.f};
   glm::vec2 scale_ = {1.0, 1.0};
+
+  // Cached affine transformation. Recomputed lazily after the parameters above
+  // are modified.
+  mutable glm::mat3x2 affine_ = glm::mat3x2(1.f);
+  mutable bool affine_dirty_ = false;
 };
 
 /// A 2D Drawable object supporting several transformations:
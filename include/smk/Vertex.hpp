@@ -5,6 +5,7 @@
 #ifndef SMK_VERTEX_HPP
 #define SMK_VERTEX_HPP
 
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace smk {
@@ -26,6 +27,38 @@ struct Vertex3D {
   static void Bind();
 };
 
+/// The vertex structure suitable for a 2D shader, with a color per vertex.
+/// The color is packed as 8 bits per channel, red in the lowest byte.
+struct Vertex2DColor {
+  Vertex2DColor() = default;
+  Vertex2DColor(const glm::vec2& space_position,
+                const glm::vec2& texture_position,
+                uint32_t color)
+      : space_position(space_position),
+        texture_position(texture_position),
+        color(color) {}
+
+  glm::vec2 space_position = {0.f, 0.f};
+  glm::vec2 texture_position = {0.f, 0.f};
+  uint32_t color = 0xFFFFFFFF;
+
+  static void Bind();
+};
+
+/// The vertex structure of smk::ShapeBatch. Each vertex carries the parameters
+/// of the shape it belongs to, evaluated as a signed distance field.
+struct Vertex2DShape {
+  glm::vec2 space_position = {0.f, 0.f};
+  glm::vec2 local_position = {0.f, 0.f};  ///< Relative to the shape's center.
+  glm::vec2 half_size = {0.f, 0.f};       ///< Half of the shape's box.
+  float radius = 0.f;                     ///< The corner radius.
+  float border = 0.f;                     ///< The border width.
+  uint32_t color = 0xFFFFFFFF;
+  uint32_t border_color = 0xFFFFFFFF;
+
+  static void Bind();
+};
+
 using Vertex = Vertex2D;
 
 }  // namespace smk.
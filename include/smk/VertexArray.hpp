@@ -7,6 +7,7 @@
 
 #include <initializer_list>
 #include <smk/OpenGL.hpp>
+#include <smk/Rectangle.hpp>
 #include <smk/Vertex.hpp>
 #include <vector>
 
@@ -15,6 +16,9 @@ namespace smk {
 /// @brief An array of smk::Vertex moved to the GPU memory. This represent a set
 /// of triangles to be drawn by the GPU.
 ///
+/// The triangles are either consecutive triplets of vertices, or consecutive
+/// triplets of indices into the vertices (indexed VertexArray).
+///
 /// This class is movable and copyable. It is refcounted. The GPU data is
 /// automatically released when the last smk::VertextArray is deleted.
 class VertexArray {
@@ -22,6 +26,26 @@ class VertexArray {
   VertexArray();  // The null VertexArray.
   VertexArray(const std::vector<Vertex2D>& array);
   VertexArray(const std::vector<Vertex3D>& array);
+  VertexArray(const std::vector<Vertex2DColor>& array);
+
+  // Indexed triangles.
+  VertexArray(const std::vector<Vertex2D>& array,
+              const std::vector<GLuint>& indices);
+  VertexArray(const std::vector<Vertex3D>& array,
+              const std::vector<GLuint>& indices);
+  VertexArray(const std::vector<Vertex2DColor>& array,
+              const std::vector<GLuint>& indices);
+  VertexArray(const std::vector<Vertex2DShape>& array,
+              const std::vector<GLuint>& indices);
+
+  // Replace the vertices, reusing the GPU buffer. This is meant for vertices
+  // rewritten every frame.
+  void Update(const std::vector<Vertex2DColor>& array,
+              size_t size,
+              const Rectangle& bounding_box);
+  void Update(const std::vector<Vertex2DShape>& array,
+              size_t size,
+              const Rectangle& bounding_box);
 
   ~VertexArray();
 
@@ -38,14 +62,30 @@ class VertexArray {
   bool operator!=(const smk::VertexArray&) const;
 
   size_t size() const;
+  bool indexed() const;
+
+  // The smallest rectangle containing every vertices. For 3D vertices, this is
+  // the projection on the (x,y) plane.
+  const Rectangle& bounding_box() const;
+
+  // The center of the box bounding every vertices, including along z.
+  glm::vec3 center() const;
 
  private:
   void Allocate(int element_size, void* data);
+  void AllocateIndices(const std::vector<GLuint>& indices);
+  void Upload(const void* data,
+              size_t bytes,
+              size_t size,
+              const Rectangle& bounding_box);
   void Release();
 
   GLuint vbo_ = 0;
   GLuint vao_ = 0;
+  GLuint ebo_ = 0;
   size_t size_ = 0u;
+  Rectangle bounding_box_ = {0.f, 0.f, 0.f, 0.f};
+  float center_z_ = 0.f;
 
   // Used to support copy. Nullptr as long as this class is not copied.
   // Otherwise an integer counting how many instances shares this resource.
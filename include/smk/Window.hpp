@@ -5,9 +5,11 @@
 #ifndef SMK_WINDOW_HPP
 #define SMK_WINDOW_HPP
 
+#include <atomic>
 #include <functional>
 #include <glm/glm.hpp>
 #include <memory>
+#include <smk/FramePacer.hpp>
 #include <smk/RenderTarget.hpp>
 #include <string>
 
@@ -32,6 +34,7 @@ class Window : public RenderTarget {
  public:
   Window();
   Window(int width, int height, const std::string& title);
+  Window(int width, int height, const std::string& title, int samples);
   ~Window();
 
   GLFWwindow* window() const;
@@ -52,6 +55,19 @@ class Window : public RenderTarget {
   // (optional).
   void LimitFrameRate(float fps);
 
+  // Vsync, frame rate cap and frame time statistics, used by ExecuteMainLoop.
+  FramePacer& frame_pacer() { return frame_pacer_; }
+
+  // On-demand rendering: the main loop sleeps until some input arrives, an
+  // animation is running, or a redraw is requested. Disabled by default.
+  void SetOnDemandRendering(bool on_demand);
+  bool on_demand_rendering() const { return on_demand_; }
+  void RequestRedraw();  // Can be called from any thread.
+  void RequestAnimation(float duration);
+  // While idle, redraw at least every |timeout| seconds. Zero or negative
+  // waits indefinitely.
+  void SetIdleTimeout(float timeout);
+
   // Returns true when the user wants to close the window.
   bool ShouldClose();
 
@@ -66,9 +82,18 @@ class Window : public RenderTarget {
 
   // Time:
   float time_ = 0.f;
-  float time_last_sleep_ = 0.f;
+  FramePacer frame_pacer_;
+
+  // On-demand rendering:
+  bool on_demand_ = false;
+  std::atomic<bool> redraw_requested_{true};
+  double animation_end_ = 0.0;
+  double last_redraw_ = 0.0;
+  float idle_timeout_ = 0.f;
 
   void UpdateDimensions();
+  bool ShouldRedraw();
+  void WaitForRedraw();
 
   std::unique_ptr<InputImpl> input_;
   int id_ = 0;
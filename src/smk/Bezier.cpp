@@ -0,0 +1,207 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <cmath>
+#include <smk/Bezier.hpp>
+
+namespace smk {
+namespace Bezier {
+
+namespace {
+
+constexpr size_t max_subdivisions = 1 << 16;  // NOLINT
+
+// Above this degree, the power basis loses too much precision in single
+// precision floating point.
+constexpr size_t max_power_basis_size = 8;
+
+// de Casteljau's algorithm, for the curves of higher degree.
+void EvaluateDeCasteljau(const glm::vec2* control_points,
+                         size_t size,
+                         size_t subdivision,
+                         glm::vec2* output) {
+  glm::vec2 buffer[max_control_points];
+  std::vector<glm::vec2> heap_buffer;
+  glm::vec2* data = buffer;
+  if (size > max_control_points) {
+    heap_buffer.resize(size);
+    data = heap_buffer.data();
+  }
+
+  for (size_t k = 0; k <= subdivision; ++k) {
+    const float t = float(k) / float(subdivision);
+    std::copy(control_points, control_points + size, data);
+    for (size_t n = size - 1; n >= 1; --n) {
+      for (size_t i = 0; i < n; ++i) {
+        data[i] = glm::mix(data[i], data[i + 1], t);
+      }
+    }
+    output[k] = data[0];
+  }
+}
+
+// Append the curve to |output|. When |continuation| is set, the first point is
+// assumed to be already the last one of |output|.
+void Append(const glm::vec2* control_points,
+            size_t size,
+            float tolerance,
+            bool continuation,
+            std::vector<glm::vec2>* output) {
+  const size_t subdivision = Subdivisions(control_points, size, tolerance);
+  const size_t begin =
+      continuation && !output->empty() ? output->size() - 1 : output->size();
+  output->resize(begin + subdivision + 1);
+  Evaluate(control_points, size, subdivision, output->data() + begin);
+}
+
+}  // namespace
+
+/// @brief Evaluate a Bezier curve at evenly spaced parameters.
+/// @param control_points The control points of the curve.
+/// @param size The number of control points.
+/// @param subdivision The number of segments. |output| receives
+///                    |subdivision| + 1 points.
+/// @param output The buffer receiving the points.
+void Evaluate(const glm::vec2* control_points,
+              size_t size,
+              size_t subdivision,
+              glm::vec2* output) {
+  if (size == 0) {
+    return;
+  }
+
+  const size_t degree = size - 1;
+  if (subdivision == 0 || degree == 0) {
+    std::fill(output, output + subdivision + 1, control_points[0]);
+    return;
+  }
+
+  if (size > max_power_basis_size) {
+    EvaluateDeCasteljau(control_points, size, subdivision, output);
+    return;
+  }
+
+  // Power basis: B(t) = sum_j binomial(n, j) * Δ^j P_0 * t^j
+  glm::vec2 coefficients[max_power_basis_size];
+  glm::vec2 differences[max_power_basis_size];
+  std::copy(control_points, control_points + size, differences);
+  float binomial = 1.F;
+  for (size_t j = 0; j <= degree; ++j) {
+    coefficients[j] = binomial * differences[0];
+    for (size_t i = 0; i + j < degree; ++i) {
+      differences[i] = differences[i + 1] - differences[i];
+    }
+    binomial = binomial * float(degree - j) / float(j + 1);
+  }
+
+  // Horner's method. The samples are independent, so the inner loops can be
+  // vectorized.
+  const float step = 1.F / float(subdivision);
+  std::fill(output, output + subdivision + 1, coefficients[degree]);
+  for (size_t j = degree; j-- > 0;) {
+    const glm::vec2 coefficient = coefficients[j];
+    for (size_t k = 0; k <= subdivision; ++k) {
+      output[k] = output[k] * (float(k) * step) + coefficient;
+    }
+  }
+
+  // Keep the end exact, despite rounding errors.
+  output[subdivision] = control_points[degree];
+}
+
+/// @brief The number of segments needed to approximate a Bezier curve.
+///
+/// Use Wang's formula: the distance in between the curve and the polyline
+/// evaluated at evenly spaced parameters is bounded by the second differences
+/// of the control points.
+/// @param control_points The control points of the curve.
+/// @param size The number of control points.
+/// @param tolerance The maximal distance in between the curve and the
+///                  polyline.
+size_t Subdivisions(const glm::vec2* control_points,
+                    size_t size,
+                    float tolerance) {
+  if (size <= 2) {
+    return 1;
+  }
+
+  float second_difference = 0.F;
+  for (size_t i = 0; i + 2 < size; ++i) {
+    const glm::vec2 d = control_points[i + 2] - 2.F * control_points[i + 1] +
+                        control_points[i];
+    second_difference = std::max(second_difference, glm::length(d));
+  }
+
+  const float degree = float(size - 1);
+  tolerance = std::max(tolerance, 1e-3F);  // NOLINT
+  const float subdivision = std::ceil(std::sqrt(
+      degree * (degree - 1.F) * second_difference / (8.F * tolerance)));
+  return std::max(size_t(1), std::min(max_subdivisions, size_t(subdivision)));
+}
+
+/// @brief Approximate a Bezier curve with a polyline.
+/// @param control_points The control points of the curve.
+/// @param size The number of control points.
+/// @param tolerance The maximal distance in between the curve and the
+///                  polyline.
+/// @param output The points are appended to it.
+void Flatten(const glm::vec2* control_points,
+             size_t size,
+             float tolerance,
+             std::vector<glm::vec2>* output) {
+  if (size == 0) {
+    return;
+  }
+  Append(control_points, size, tolerance, false, output);
+}
+
+/// @brief Approximate a piecewise cubic Bezier spline with a polyline.
+/// @param points The ends and control points of the successive cubic curves.
+///               Consecutive curves share their end.
+/// @param size The number of points. The trailing points not forming a
+///             complete curve are ignored.
+/// @param tolerance The maximal distance in between the spline and the
+///                  polyline.
+/// @param output The points are appended to it.
+void Spline(const glm::vec2* points,
+            size_t size,
+            float tolerance,
+            std::vector<glm::vec2>* output) {
+  if (size < 4) {
+    return;
+  }
+  for (size_t i = 0; i + 3 < size; i += 3) {
+    Append(points + i, 4, tolerance, i != 0, output);
+  }
+}
+
+/// @brief Approximate a Catmull-Rom spline with a polyline.
+/// @param points The points the spline is going through.
+/// @param size The number of points.
+/// @param tolerance The maximal distance in between the spline and the
+///                  polyline.
+/// @param output The points are appended to it.
+void CatmullRom(const glm::vec2* points,
+                size_t size,
+                float tolerance,
+                std::vector<glm::vec2>* output) {
+  if (size == 1) {
+    output->push_back(points[0]);
+  }
+  for (size_t i = 0; i + 1 < size; ++i) {
+    const glm::vec2& previous = points[i == 0 ? 0 : i - 1];
+    const glm::vec2& next = points[std::min(i + 2, size - 1)];
+    const glm::vec2 cubic[4] = {
+        points[i],
+        points[i] + (points[i + 1] - previous) / 6.F,  // NOLINT
+        points[i + 1] - (next - points[i]) / 6.F,      // NOLINT
+        points[i + 1],
+    };
+    Append(cubic, 4, tolerance, i != 0, output);
+  }
+}
+
+}  // namespace Bezier
+}  // namespace smk
@@ -25,6 +25,17 @@ glm::vec4 RGB(float red, float green, float blue) {
   return {red, green, blue, 1.F};
 }
 
+/// @brief Pack a color into 8 bits per channel, red in the lowest byte. This is
+/// the layout of the per-vertex colors. @see smk::Vertex2DColor.
+/// @param color: The color. Its components are clamped into [0,1].
+uint32_t Pack(const glm::vec4& color) {
+  const glm::vec4 c = glm::clamp(color, 0.F, 1.F) * 255.F + 0.5F;  // NOLINT
+  return uint32_t(c.r) |                                           //
+         uint32_t(c.g) << 8U |                                     // NOLINT
+         uint32_t(c.b) << 16U |                                    // NOLINT
+         uint32_t(c.a) << 24U;                                     // NOLINT
+}
+
 // clang-format off
 const glm::vec4 White       = {1.F, 1.F, 1.F, 1.F}; ///< White
 const glm::vec4 Black       = {0.F, 0.F, 0.F, 1.F}; ///< Black
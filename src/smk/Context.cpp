@@ -0,0 +1,170 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <iostream>
+#include <map>
+#include <smk/Color.hpp>
+#include <smk/Context.hpp>
+#include <stdexcept>
+
+#ifdef __EMSCRIPTEN__
+  #include <emscripten.h>
+  #include <emscripten/html5.h>
+#endif
+
+namespace smk {
+
+bool g_khr_parallel_shader = false;  // NOLINT
+bool g_timer_query = false;          // NOLINT
+
+namespace {
+
+void GLFWErrorCallback(int error, const char* description) {
+  std::cerr << "GFLW error n°" << error << std::endl;
+  std::cerr << "~~~" << std::endl;
+  std::cerr << description << std::endl;
+  std::cerr << "~~~" << std::endl;
+  fprintf(stderr, "Error: %s\n", description); // NOLINT
+}
+
+#if !defined NDEBUG && !defined __EMSCRIPTEN__ && __linux__
+void OpenGLDebugMessageCallback(GLenum /*source*/,
+                                GLenum type,
+                                GLuint /*g_next_id*/,
+                                GLenum /*severity*/,
+                                GLsizei length,
+                                const GLchar* message,
+                                const void* /*userParam*/) {
+  if (type == GL_DEBUG_TYPE_OTHER) {
+    return;
+  }
+  std::cerr << "SMK > OpenGL error: " << std::string(message, length)
+            << std::endl;
+}
+#endif
+
+using ReleaseCallbackMap = std::map<int, std::function<void()>>;
+
+// Never destroyed: the ContextResource unregister themselves from their
+// destructor, which might run after the destruction of other statics.
+ReleaseCallbackMap& ReleaseCallbacks() {
+  static auto* callbacks = new ReleaseCallbackMap();  // NOLINT
+  return *callbacks;
+}
+
+int g_next_release_callback = 0;  // NOLINT
+
+}  // namespace
+
+void ReleaseContextResources() {
+  for (auto& it : ReleaseCallbacks()) {
+    it.second();
+  }
+  ResetRenderTargetCache();
+}
+
+int AddContextReleaseCallback(std::function<void()> release) {
+  const int id = g_next_release_callback++;
+  ReleaseCallbacks()[id] = std::move(release);
+  return id;
+}
+
+void RemoveContextReleaseCallback(int id) {
+  ReleaseCallbacks().erase(id);
+}
+
+ShaderProgram LinkShaderProgram(const Shader& vertex_shader,
+                                const Shader& fragment_shader,
+                                bool textured) {
+  ShaderProgram program;
+  program.AddShader(vertex_shader);
+  program.AddShader(fragment_shader);
+  program.Link();
+
+  GLint current_program = 0;
+  glGetIntegerv(GL_CURRENT_PROGRAM, &current_program);
+  program.Use();
+  if (textured) {
+    program.SetUniform("texture_0", 0);
+  }
+  program.SetUniform("color", Color::White);
+  glUseProgram(GLuint(current_program));
+  return program;
+}
+
+GLFWwindow* CreateContext(int width,
+                          int height,
+                          const std::string& title,
+                          bool visible,
+                          int samples) {
+  glfwSetErrorCallback(GLFWErrorCallback);
+  // initialize the GLFW library
+  if (!glfwInit()) {
+    throw std::runtime_error("Couldn't init GLFW");
+  }
+
+  // setting the opengl version
+#ifdef __EMSCRIPTEN__
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+#else
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+  glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif
+
+  glfwWindowHint(GLFW_RESIZABLE, GL_TRUE);
+  glfwWindowHint(GLFW_SAMPLES, samples);
+  glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
+
+  // create the window_
+  GLFWwindow* window =
+      glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+  if (!window) {
+    glfwTerminate();
+    throw std::runtime_error("Couldn't create a window_");
+  }
+
+  glfwMakeContextCurrent(window);
+
+#ifndef __EMSCRIPTEN__
+  glewExperimental = GL_TRUE;
+  GLenum err = glewInit();
+
+  if (err != GLEW_OK) {
+    glfwTerminate();
+    std::string error = (const char*)glewGetErrorString(err);  // NOLINT
+    throw std::runtime_error("Could initialize GLEW, error = " + error);
+  }
+#endif
+
+#if !defined NDEBUG && !defined __EMSCRIPTEN__ && __linux__
+  glEnable(GL_DEBUG_OUTPUT);
+  glDebugMessageCallback(OpenGLDebugMessageCallback, 0);
+#endif
+
+  // Alpha transparency.
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+#ifndef __EMSCRIPTEN__
+  if (GLEW_KHR_parallel_shader_compile) {
+    glMaxShaderCompilerThreadsKHR(4);
+    g_khr_parallel_shader = true;
+  }
+#else
+  g_khr_parallel_shader = emscripten_webgl_enable_extension(
+      emscripten_webgl_get_current_context(), "KHR_parallel_shader_compile");
+#endif
+
+  // GPU timestamps, used by the Profiler. WebGL doesn't expose them.
+#ifndef __EMSCRIPTEN__
+  g_timer_query = GLEW_ARB_timer_query;
+#endif
+
+  return window;
+}
+
+}  // namespace smk
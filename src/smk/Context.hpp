@@ -0,0 +1,82 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef SMK_CONTEXT_H_
+#define SMK_CONTEXT_H_
+
+#include <functional>
+#include <memory>
+#include <smk/OpenGL.hpp>
+#include <smk/Shader.hpp>
+#include <string>
+
+namespace smk {
+
+// Create a GLFW window and make its OpenGL context current. The OpenGL
+// functions are loaded. |samples| is the number of samples per pixel of the
+// window's framebuffer (multisample antialiasing), zero disables it. Throw
+// std::runtime_error on failure.
+GLFWwindow* CreateContext(int width,
+                          int height,
+                          const std::string& title,
+                          bool visible,
+                          int samples);
+
+// Release the OpenGL objects kept in static storage, and forget the OpenGL
+// state cached by the RenderTargets. Call it before destroying an OpenGL
+// context, while it is still current. The objects are built again on demand,
+// in the next context.
+void ReleaseContextResources();
+
+// Register |release|, called by ReleaseContextResources(). Return an
+// identifier for RemoveContextReleaseCallback().
+int AddContextReleaseCallback(std::function<void()> release);
+void RemoveContextReleaseCallback(int id);
+
+// Forget the OpenGL state cached by the RenderTargets. Defined in
+// RenderTarget.cpp.
+void ResetRenderTargetCache();
+
+// Link a ShaderProgram used internally by smk, and set its default uniforms:
+// "color" to white and, when |textured|, "texture_0" to the texture unit 0. The
+// program in use isn't modified.
+ShaderProgram LinkShaderProgram(const Shader& vertex_shader,
+                                const Shader& fragment_shader,
+                                bool textured);
+
+// An OpenGL object kept in static storage, for the lifetime of the OpenGL
+// context. It is built on first use, and released by
+// ReleaseContextResources().
+template <typename T>
+class ContextResource {
+ public:
+  explicit ContextResource(std::function<T()> build)
+      : build_(std::move(build)),
+        release_id_(AddContextReleaseCallback([this] { value_.reset(); })) {}
+
+  // At exit, the OpenGL context might already be gone. Leak the object instead
+  // of calling OpenGL without a context.
+  ~ContextResource() {
+    RemoveContextReleaseCallback(release_id_);
+    value_.release();  // NOLINT
+  }
+
+  T& Get() {
+    if (!value_) {
+      value_ = std::make_unique<T>(build_());
+    }
+    return *value_;
+  }
+
+  ContextResource(const ContextResource&) = delete;
+  ContextResource& operator=(const ContextResource&) = delete;
+
+ private:
+  std::function<T()> build_;
+  std::unique_ptr<T> value_;
+  int release_id_ = 0;
+};
+
+}  // namespace smk
+
+#endif /* end of include guard: SMK_CONTEXT_H_ */
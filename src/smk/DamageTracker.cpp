@@ -0,0 +1,232 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <smk/BlendMode.hpp>
+#include <smk/Color.hpp>
+#include <smk/Context.hpp>
+#include <smk/DamageTracker.hpp>
+#include <smk/RenderState.hpp>
+#include <smk/RenderTarget.hpp>
+#include <smk/Shader.hpp>
+#include <smk/Transformable.hpp>
+
+namespace smk {
+
+namespace {
+
+constexpr size_t default_max_rectangles = 4;
+
+// Antialiasing and texture filtering can bleed slightly outside of the
+// bounding boxes.
+constexpr float margin = 2.F;
+
+// Copy the texture of a Framebuffer, using RenderTarget::DrawFullScreen.
+ShaderProgram& CopyShaderProgram() {
+  static ContextResource<ShaderProgram> shader_program([] {
+    auto vertex_shader = Shader::FromString(R"(
+      layout(location = 0) in vec2 space_position;
+      layout(location = 1) in vec2 texture_position;
+
+      out vec2 f_texture_position;
+
+      void main() {
+        f_texture_position = texture_position;
+        gl_Position = vec4(space_position, 0.0, 1.0);
+      }
+    )",
+                                            GL_VERTEX_SHADER);
+
+    auto fragment_shader = Shader::FromString(R"(
+      in vec2 f_texture_position;
+      uniform sampler2D texture_0;
+      uniform vec4 color;
+      out vec4 out_color;
+
+      void main() {
+        out_color = texture(texture_0, f_texture_position) * color;
+      }
+    )",
+                                              GL_FRAGMENT_SHADER);
+
+    return LinkShaderProgram(vertex_shader, fragment_shader,
+                             /*textured=*/true);
+  });
+  return shader_program.Get();
+}
+
+}  // namespace
+
+/// @brief A DamageTracker, drawing at most 4 rectangles per frame.
+DamageTracker::DamageTracker() : DamageTracker(default_max_rectangles) {}
+
+/// @brief A DamageTracker.
+/// @param max_rectangles The maximum number of rectangles drawn per frame.
+///                       Above, the closest ones are merged.
+DamageTracker::DamageTracker(size_t max_rectangles)
+    : max_rectangles_(std::max(max_rectangles, size_t(1))) {}
+
+/// @brief Report a region whose content changed.
+/// @param region The region, in pixels. (0,0) is the top-left corner.
+void DamageTracker::Invalidate(const Rectangle& region) {
+  if (everything_) {
+    return;
+  }
+
+  const Rectangle rounded = {
+      std::floor(region.left),
+      std::floor(region.top),
+      std::ceil(region.right),
+      std::ceil(region.bottom),
+  };
+  if (rounded.width() <= 0.F || rounded.height() <= 0.F) {
+    return;
+  }
+
+  rectangles_.push_back(rounded);
+  Merge();
+}
+
+/// @brief Report the pixels currently covered by a drawable. Call it before
+/// and after modifying the drawable, to report both where it was and where it
+/// is.
+///
+/// The bounds are the ones of the drawable's vertex_array(). smk::Text draws
+/// its glyphs with their own vertex arrays: use the other overload with the
+/// bounds of the text instead.
+/// @param target The RenderTarget, whose View is used to draw |drawable|.
+/// @param drawable The drawable.
+void DamageTracker::Invalidate(const RenderTarget& target,
+                               const TransformableBase& drawable) {
+  Invalidate(target, drawable.vertex_array().bounding_box(),
+             drawable.transformation());
+}
+
+/// @brief Report the pixels currently covered by a drawable, given its bounds.
+///
+/// Example:
+/// ~~~cpp
+/// glm::vec2 dimensions = text.ComputeDimensions();
+/// damage.Invalidate(window, {0.f, 0.f, dimensions.x, dimensions.y},
+///                   text.transformation());
+/// ~~~
+/// @param target The RenderTarget, whose View is used to draw the drawable.
+/// @param bounding_box The bounds of the drawable, in its local coordinates.
+/// @param transformation The transformation of the drawable.
+void DamageTracker::Invalidate(const RenderTarget& target,
+                               const Rectangle& bounding_box,
+                               const glm::mat4& transformation) {
+  Rectangle bounds = target.PixelBounds(bounding_box, transformation);
+  bounds.left -= margin;
+  bounds.top -= margin;
+  bounds.right += margin;
+  bounds.bottom += margin;
+  Invalidate(bounds);
+}
+
+/// @brief Draw everything again during the next frame.
+void DamageTracker::InvalidateAll() {
+  everything_ = true;
+  rectangles_.clear();
+}
+
+// Merge the overlapping rectangles. Then, while there are too many of them,
+// merge the pair whose union adds the smallest area.
+void DamageTracker::Merge() {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (size_t i = 0; i < rectangles_.size() && !merged; ++i) {
+      for (size_t j = i + 1; j < rectangles_.size() && !merged; ++j) {
+        if (rectangles_[i].Intersects(rectangles_[j])) {
+          rectangles_[i] = rectangles_[i].Union(rectangles_[j]);
+          rectangles_.erase(rectangles_.begin() + j);
+          merged = true;
+        }
+      }
+    }
+
+    if (merged || rectangles_.size() <= max_rectangles_) {
+      continue;
+    }
+
+    size_t best_i = 0;
+    size_t best_j = 1;
+    float best_cost = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < rectangles_.size(); ++i) {
+      for (size_t j = i + 1; j < rectangles_.size(); ++j) {
+        const float cost = rectangles_[i].Union(rectangles_[j]).area() -
+                           rectangles_[i].area() - rectangles_[j].area();
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_i = i;
+          best_j = j;
+        }
+      }
+    }
+    rectangles_[best_i] = rectangles_[best_i].Union(rectangles_[best_j]);
+    rectangles_.erase(rectangles_.begin() + best_j);
+    merged = true;
+  }
+}
+
+/// @brief Draw the damaged regions, then copy the result into |target|.
+///
+/// The persistent Framebuffer is (re)allocated to the size of |target|. When
+/// it is, everything is drawn. It receives the View of |target| before |draw|
+/// is called.
+/// @param target The RenderTarget to copy the frame into, usually the Window.
+/// @param draw Draw the frame into the RenderTarget it receives. It is called
+///             once per damaged region, with a scissor rectangle. It isn't
+///             called when nothing changed.
+void DamageTracker::Draw(RenderTarget& target,
+                         const std::function<void(RenderTarget&)>& draw) {
+  const int width = target.width();
+  const int height = target.height();
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+
+  if (!framebuffer_ || framebuffer_->width() != width ||
+      framebuffer_->height() != height) {
+    framebuffer_ = std::make_unique<Framebuffer>(width, height);
+    InvalidateAll();
+  }
+
+  if (everything_) {
+    rectangles_ = {{0.F, 0.F, float(width), float(height)}};
+  }
+
+  framebuffer_->SetView(target.view());
+  float redrawn_area = 0.F;
+  for (const Rectangle& rectangle : rectangles_) {
+    const Rectangle clipped = {
+        std::max(rectangle.left, 0.F),
+        std::max(rectangle.top, 0.F),
+        std::min(rectangle.right, float(width)),
+        std::min(rectangle.bottom, float(height)),
+    };
+    if (clipped.width() <= 0.F || clipped.height() <= 0.F) {
+      continue;
+    }
+    framebuffer_->SetScissor(clipped);
+    draw(*framebuffer_);
+    redrawn_area += clipped.area();
+  }
+  framebuffer_->ResetScissor();
+  redrawn_fraction_ = redrawn_area / (float(width) * float(height));
+  rectangles_.clear();
+  everything_ = false;
+
+  RenderState state;
+  state.shader_program = CopyShaderProgram();
+  state.texture = framebuffer_->color_texture();
+  state.color = Color::White;
+  state.blend_mode = BlendMode::Replace;
+  target.DrawFullScreen(state);
+}
+
+}  // namespace smk
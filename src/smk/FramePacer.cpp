@@ -0,0 +1,202 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <smk/FramePacer.hpp>
+#include <smk/OpenGL.hpp>
+#include <thread>
+
+namespace smk {
+
+namespace {
+
+constexpr size_t default_history = 240;
+
+// The bounds of the spinning duration preceding a deadline.
+constexpr std::chrono::duration<double> min_spin_duration(0.0002);
+constexpr std::chrono::duration<double> max_spin_duration(0.004);
+
+// A frame misses its deadline when it lasts this many target periods.
+constexpr double missed_deadline_ratio = 1.5;
+
+// Some drivers ignore the swap interval. With vsync, the frame rate is capped
+// at this many times the refresh rate, so that the loop doesn't spin at 100%
+// CPU. The margin keeps the cap from ever delaying a frame when vsync works.
+constexpr double vsync_fallback_ratio = 1.25;
+
+}  // namespace
+
+/// @brief A FramePacer, collecting the statistics of the last 240 frames.
+FramePacer::FramePacer() : FramePacer(default_history) {}
+
+/// @brief A FramePacer.
+/// @param history The number of frames the statistics are computed over.
+FramePacer::FramePacer(size_t history)
+    : spin_duration_(0.002),  // NOLINT
+      history_(std::max(history, size_t(1))) {
+  frame_times_.reserve(history_);
+}
+
+/// @brief Synchronize the buffer swaps with the screen refresh. This applies
+/// to the OpenGL context current on the calling thread.
+/// @param vsync The synchronization mode.
+void FramePacer::SetVSync(VSync vsync) {
+  vsync_ = vsync;
+
+  int interval = 0;
+  switch (vsync) {
+    case VSync::Off:
+      interval = 0;
+      break;
+    case VSync::On:
+      interval = 1;
+      break;
+    case VSync::Adaptive:
+      interval = (glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+                  glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+                     ? -1
+                     : 1;
+      break;
+  }
+  glfwSwapInterval(interval);
+
+#ifndef __EMSCRIPTEN__
+  if (GLFWmonitor* monitor = glfwGetPrimaryMonitor()) {
+    if (const GLFWvidmode* mode = glfwGetVideoMode(monitor)) {
+      refresh_rate_ = float(mode->refreshRate);
+    }
+  }
+#endif
+}
+
+/// @brief Cap the frame rate. Without vsync, this avoids rendering frames that
+/// will never be displayed. On WebAssembly, the browser schedules the frames
+/// and the cap is ignored.
+/// @param fps The maximum number of frames per second. Zero or negative
+///            disables the cap.
+void FramePacer::SetFrameRateLimit(float fps) {
+  frame_rate_limit_ = fps;
+}
+
+/// @brief Wait until the deadline of the next frame, and record the duration
+/// of the frame. Call it once per frame, after Window::Display().
+///
+/// When a deadline is missed, the next ones are rescheduled from now, instead
+/// of rendering the late frames in a burst.
+void FramePacer::Wait() {
+  ++frame_count_;
+
+#ifndef __EMSCRIPTEN__
+  const double frame_rate_cap = FrameRateCap();
+  if (frame_rate_cap > 0.0) {
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        Seconds(1.0 / frame_rate_cap));
+    deadline_ += period;
+    const auto now = Clock::now();
+    if (deadline_ < now) {
+      deadline_ = now;
+    } else {
+      SleepUntil(deadline_);
+    }
+  }
+#endif
+
+  Record(Clock::now());
+}
+
+// Sleep until shortly before |deadline|, then spin. The sleep overshoot is
+// measured, to adapt the spinning duration.
+void FramePacer::SleepUntil(Clock::time_point deadline) {
+  const auto wake_up =
+      deadline - std::chrono::duration_cast<Clock::duration>(spin_duration_);
+  const auto before_sleep = Clock::now();
+  if (wake_up > before_sleep) {
+    std::this_thread::sleep_until(wake_up);
+    const Seconds overshoot = Clock::now() - wake_up;
+
+    // Grow quickly, shrink slowly.
+    spin_duration_ = std::max(overshoot * 1.5, spin_duration_ * 0.99);  // NOLINT
+    spin_duration_ = std::min(std::max(spin_duration_, min_spin_duration),
+                              max_spin_duration);
+  }
+
+  while (Clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+}
+
+/// @brief Don't record the time elapsed until the next call to Wait(). Use it
+/// when the application stopped rendering on purpose, e.g. while idling.
+void FramePacer::Resume() {
+  resumed_ = true;
+}
+
+void FramePacer::Record(Clock::time_point now) {
+  if (frame_count_ > 1 && !resumed_) {
+    const float frame_time = float(Seconds(now - last_frame_).count());
+    if (frame_times_.size() < history_) {
+      frame_times_.push_back(frame_time);
+    } else {
+      frame_times_[frame_times_index_] = frame_time;
+    }
+    frame_times_index_ = (frame_times_index_ + 1) % history_;
+  }
+  resumed_ = false;
+  last_frame_ = now;
+}
+
+// The frame rate limit, or else the vsync fallback cap. Zero when uncapped.
+double FramePacer::FrameRateCap() const {
+  if (frame_rate_limit_ > 0.f) {
+    return double(frame_rate_limit_);
+  }
+  if (vsync_ != VSync::Off && refresh_rate_ > 0.f) {
+    return double(refresh_rate_) * vsync_fallback_ratio;
+  }
+  return 0.0;
+}
+
+FramePacer::Seconds FramePacer::TargetPeriod() const {
+  if (frame_rate_limit_ > 0.f) {
+    return Seconds(1.0 / double(frame_rate_limit_));
+  }
+  if (vsync_ != VSync::Off && refresh_rate_ > 0.f) {
+    return Seconds(1.0 / double(refresh_rate_));
+  }
+  return Seconds(0.0);
+}
+
+/// @brief The frame time statistics, over the last frames.
+FramePacer::Statistics FramePacer::statistics() const {
+  Statistics statistics;
+  statistics.frames = frame_times_.size();
+  if (frame_times_.empty()) {
+    return statistics;
+  }
+
+  const float target = float(TargetPeriod().count());
+  float sum = 0.f;
+  for (float frame_time : frame_times_) {
+    sum += frame_time;
+    statistics.max = std::max(statistics.max, frame_time);
+    if (target > 0.f && frame_time > target * missed_deadline_ratio) {
+      ++statistics.missed_deadlines;
+    }
+  }
+  statistics.mean = sum / float(frame_times_.size());
+
+  std::vector<float> sorted = frame_times_;
+  const size_t p99 = (sorted.size() * 99) / 100;  // NOLINT
+  std::nth_element(sorted.begin(), sorted.begin() + p99, sorted.end());
+  statistics.p99 = sorted[p99];
+  return statistics;
+}
+
+/// @brief Forget the recorded frame times.
+void FramePacer::ResetStatistics() {
+  frame_times_.clear();
+  frame_times_index_ = 0;
+}
+
+}  // namespace smk
@@ -2,6 +2,7 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 
+#include <algorithm>
 #include <smk/Color.hpp>
 #include <smk/Drawable.hpp>
 #include <smk/Framebuffer.hpp>
@@ -12,32 +13,75 @@ namespace smk {
 /// @brief Construct a Framebuffer of a given dimensions.
 /// @param width The width of the drawing surface.
 /// @param height The width of the drawing surface.
-Framebuffer::Framebuffer(int width, int height) {
-  Texture::Option option;
-  option.internal_format = GL_RGB;
-  option.format = GL_RGB;
-  option.type = GL_UNSIGNED_BYTE;
-  option.generate_mipmap = false;
-  option.min_filter = GL_LINEAR;
-  option.mag_filter = GL_LINEAR;
-  color_textures_.emplace_back(nullptr, width, height, option);
-
-  Init();
+Framebuffer::Framebuffer(int width, int height)
+    : Framebuffer(width, height, Option()) {}
+
+/// @brief Construct a Framebuffer of a given dimensions.
+/// @param width The width of the drawing surface.
+/// @param height The width of the drawing surface.
+/// @param option Additionnal option (format, samples, depth-stencil, ...)
+Framebuffer::Framebuffer(int width, int height, const Option& option)
+    : option_(option) {
+  GLint max_samples = 0;
+  glGetIntegerv(GL_MAX_SAMPLES, &max_samples);
+  option_.samples = std::max(0, std::min(option_.samples, int(max_samples)));
+
+  // Multisampled framebuffers are backed by renderbuffers instead of textures.
+  if (option_.samples == 0) {
+    Texture::Option texture_option;
+    texture_option.internal_format = option_.internal_format;
+    texture_option.format = option_.format;
+    texture_option.type = option_.type;
+    texture_option.generate_mipmap = false;
+    texture_option.min_filter = GL_LINEAR;
+    texture_option.mag_filter = GL_LINEAR;
+    for (int i = 0; i < option_.color_attachments; ++i) {
+      color_textures_.emplace_back(nullptr, width, height, texture_option);
+    }
+  }
+
+  Init(width, height);
 }
 
 /// @brief Construct a Framebuffer from a list of color textures. Those textures
 /// must be constructed with not mipmap. See Texture::Option::generate_mipma^
 // /and Texture::Option::min_filter.
-/// @param width The width of the drawing surface.
-/// @param height The width of the drawing surface.
+/// @param color_textures The textures to draw into. The i-th texture is
+///                       attached to GL_COLOR_ATTACHMENT0 + i.
 Framebuffer::Framebuffer(std::vector<Texture> color_textures)
     : color_textures_(std::move(color_textures)) {
-  Init();
+  option_.color_attachments = int(color_textures_.size());
+  Init(color_texture().width(), color_texture().height());
 }
 
-void Framebuffer::Init() {
-  width_ = color_texture().width();
-  height_ = color_texture().height();
+/// @brief Construct a multisampled Framebuffer. Use Framebuffer::ResolveTo to
+/// read its content.
+/// @param width The width of the drawing surface.
+/// @param height The width of the drawing surface.
+/// @param samples The number of samples per pixel.
+Framebuffer::Framebuffer(int width, int height, int samples)
+    : Framebuffer(width, height, samples, 1) {}
+
+/// @brief Construct a multisampled Framebuffer with several color attachments.
+/// Use Framebuffer::ResolveTo to read its content.
+/// @param width The width of the drawing surface.
+/// @param height The width of the drawing surface.
+/// @param samples The number of samples per pixel.
+/// @param color_attachments The number of color attachments.
+Framebuffer::Framebuffer(int width,
+                         int height,
+                         int samples,
+                         int color_attachments)
+    : Framebuffer(width, height, [&] {
+        Option option;
+        option.samples = samples;
+        option.color_attachments = color_attachments;
+        return option;
+      }()) {}
+
+void Framebuffer::Init(int width, int height) {
+  width_ = width;
+  height_ = height;
 
   // The frame buffer.
   glGenFramebuffers(1, &frame_buffer_);
@@ -45,19 +89,35 @@ void Framebuffer::Init() {
 
   // Attach the textures to the framebuffer.
   for (size_t i = 0; i < color_textures_.size(); ++i) {
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i,
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GLenum(GL_COLOR_ATTACHMENT0 + i),
                            GL_TEXTURE_2D, color_textures_[i].id(), 0);
   }
 
-  // The render buffer.
-  glGenRenderbuffers(1, &render_buffer_);
-  glBindRenderbuffer(GL_RENDERBUFFER, render_buffer_);
-  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width_, height_);
-  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+  // Multisampled framebuffers are backed by renderbuffers instead.
+  if (color_textures_.empty()) {
+    color_render_buffers_.resize(option_.color_attachments);
+    glGenRenderbuffers(option_.color_attachments, color_render_buffers_.data());
+    for (int i = 0; i < option_.color_attachments; ++i) {
+      glBindRenderbuffer(GL_RENDERBUFFER, color_render_buffers_[i]);
+      glRenderbufferStorageMultisample(GL_RENDERBUFFER, option_.samples,
+                                       GLenum(option_.internal_format), width_,
+                                       height_);
+      glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i,
+                                GL_RENDERBUFFER, color_render_buffers_[i]);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+  }
 
-  // Attach it to the framebuffer.
-  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
-                            GL_RENDERBUFFER, render_buffer_);
+  // Without this, only the first attachment would be written.
+  std::vector<GLenum> draw_buffers;
+  for (int i = 0; i < option_.color_attachments; ++i) {
+    draw_buffers.push_back(GL_COLOR_ATTACHMENT0 + i);
+  }
+  glDrawBuffers(GLsizei(draw_buffers.size()), draw_buffers.data());
+
+  if (option_.depth_stencil) {
+    AllocateDepthStencil();
+  }
 
   if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
     std::cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!"
@@ -69,6 +129,32 @@ void Framebuffer::Init() {
   InitRenderTarget();
 }
 
+/// @brief Allocate and attach the depth-stencil renderbuffer. This is done by
+/// default, unless Option::depth_stencil is false. This function does nothing
+/// when the renderbuffer already exists.
+void Framebuffer::AttachDepthStencil() {
+  if (render_buffer_) {
+    return;
+  }
+  option_.depth_stencil = true;
+  Bind(this);
+  AllocateDepthStencil();
+}
+
+// Assume the framebuffer to be bound.
+void Framebuffer::AllocateDepthStencil() {
+  // The render buffer.
+  glGenRenderbuffers(1, &render_buffer_);
+  glBindRenderbuffer(GL_RENDERBUFFER, render_buffer_);
+  glRenderbufferStorageMultisample(GL_RENDERBUFFER, option_.samples,
+                                   GL_DEPTH24_STENCIL8, width_, height_);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  // Attach it to the framebuffer.
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+                            GL_RENDERBUFFER, render_buffer_);
+}
+
 Framebuffer::~Framebuffer() {
   if (frame_buffer_) {
     glDeleteFramebuffers(1, &frame_buffer_);
@@ -79,6 +165,12 @@ Framebuffer::~Framebuffer() {
     glDeleteRenderbuffers(1, &render_buffer_);
     render_buffer_ = 0;
   }
+
+  if (!color_render_buffers_.empty()) {
+    glDeleteRenderbuffers(GLsizei(color_render_buffers_.size()),
+                          color_render_buffers_.data());
+    color_render_buffers_.clear();
+  }
 }
 
 Framebuffer::Framebuffer(Framebuffer&& other) noexcept {
@@ -87,13 +179,69 @@ Framebuffer::Framebuffer(Framebuffer&& other) noexcept {
 
 Framebuffer& Framebuffer::operator=(Framebuffer&& other) noexcept {
   RenderTarget::operator=(std::move(other));
-  std::swap(color_textures_, other.color_textures_);  // NOLINT
-  std::swap(render_buffer_, other.render_buffer_);    // NOLINT
+  std::swap(color_textures_, other.color_textures_);              // NOLINT
+  std::swap(render_buffer_, other.render_buffer_);                // NOLINT
+  std::swap(option_, other.option_);                              // NOLINT
+  std::swap(color_render_buffers_, other.color_render_buffers_);  // NOLINT
   return *this;
 }
 
+/// @brief The first color texture. Multisampled Framebuffer do not have any.
 smk::Texture& Framebuffer::color_texture() {
   return color_textures_[0];
 }
 
+/// @brief The color textures, one per color attachment. Multisampled
+/// Framebuffer do not have any.
+const std::vector<Texture>& Framebuffer::color_textures() const {
+  return color_textures_;
+}
+
+/// @brief The number of samples per pixel. Zero for regular Framebuffer.
+int Framebuffer::samples() const {
+  return option_.samples;
+}
+
+/// @brief The options used to construct this Framebuffer.
+const Framebuffer::Option& Framebuffer::option() const {
+  return option_;
+}
+
+/// @brief Copy every color attachments into |target|. The i-th attachment is
+/// copied into the i-th attachment of |target|. This is how multisampled
+/// Framebuffer are resolved.
+/// @param target The Framebuffer to copy into. When resolving a multisampled
+///               Framebuffer, it must have the same dimensions and the same
+///               Option::internal_format.
+void Framebuffer::ResolveTo(Framebuffer& target) {
+  Bind(&target);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, frame_buffer_);
+
+  const int target_attachments = target.option_.color_attachments;
+  const int attachments =
+      std::min(option_.color_attachments, target_attachments);
+
+  for (int i = 0; i < attachments; ++i) {
+    // Restrict the blit to a single pair of attachment.
+    const GLenum attachment = GLenum(GL_COLOR_ATTACHMENT0 + i);
+    std::vector<GLenum> draw_buffers(i + 1, GL_NONE);
+    draw_buffers[i] = attachment;
+    glReadBuffer(attachment);
+    glDrawBuffers(GLsizei(draw_buffers.size()), draw_buffers.data());
+    glBlitFramebuffer(0, 0, width_, height_,                //
+                      0, 0, target.width_, target.height_,  //
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  }
+
+  // Restore the state of both framebuffers.
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, target.frame_buffer_);
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+  std::vector<GLenum> draw_buffers;
+  for (int i = 0; i < target_attachments; ++i) {
+    draw_buffers.push_back(GL_COLOR_ATTACHMENT0 + i);
+  }
+  glDrawBuffers(GLsizei(draw_buffers.size()), draw_buffers.data());
+}
+
 }  // namespace smk
@@ -0,0 +1,120 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <smk/FramebufferPool.hpp>
+
+namespace smk {
+
+namespace {
+
+bool Match(const Framebuffer& framebuffer,
+           int width,
+           int height,
+           const Framebuffer::Option& option) {
+  const Framebuffer::Option& other = framebuffer.option();
+  return framebuffer.width() == width &&                         //
+         framebuffer.height() == height &&                       //
+         other.internal_format == option.internal_format &&      //
+         other.format == option.format &&                        //
+         other.type == option.type &&                            //
+         other.samples == option.samples &&                      //
+         other.color_attachments == option.color_attachments &&  //
+         // A Framebuffer with a depth-stencil buffer is fine for passes not
+         // needing one.
+         (other.depth_stencil || !option.depth_stencil);
+}
+
+}  // namespace
+
+/// @brief An empty pool.
+FramebufferPool::FramebufferPool() = default;
+
+/// @brief Return an unused Framebuffer of the given dimensions. It is valid
+/// until the next call to FramebufferPool::Recycle. Its previous content is
+/// undefined.
+/// @param width The width of the drawing surface.
+/// @param height The height of the drawing surface.
+Framebuffer& FramebufferPool::Acquire(int width, int height) {
+  return Acquire(width, height, Framebuffer::Option());
+}
+
+/// @brief Return an unused Framebuffer of the given dimensions and options. It
+/// is valid until the next call to FramebufferPool::Recycle. Its previous
+/// content is undefined.
+/// @param width The width of the drawing surface.
+/// @param height The height of the drawing surface.
+/// @param option The option of the Framebuffer.
+Framebuffer& FramebufferPool::Acquire(int width,
+                                      int height,
+                                      const Framebuffer::Option& option) {
+  // The Framebuffer clamps the number of samples to GL_MAX_SAMPLES. Compare
+  // with the clamped value, otherwise a larger request would never match.
+  Framebuffer::Option clamped = option;
+  GLint max_samples = 0;
+  glGetIntegerv(GL_MAX_SAMPLES, &max_samples);
+  clamped.samples = std::max(0, std::min(option.samples, int(max_samples)));
+
+  for (auto& entry : entries_) {
+    if (!entry.in_use && Match(*entry.framebuffer, width, height, clamped)) {
+      entry.in_use = true;
+      entry.unused_frames = 0;
+      return *entry.framebuffer;
+    }
+  }
+
+  Entry entry;
+  entry.framebuffer = std::make_unique<Framebuffer>(width, height, option);
+  entry.in_use = true;
+  entries_.push_back(std::move(entry));
+  return *entries_.back().framebuffer;
+}
+
+/// @brief Make |framebuffer| available again before the end of the frame.
+/// @param framebuffer A Framebuffer previously returned by Acquire.
+void FramebufferPool::Release(const Framebuffer& framebuffer) {
+  for (auto& entry : entries_) {
+    if (entry.framebuffer.get() == &framebuffer) {
+      entry.in_use = false;
+      return;
+    }
+  }
+}
+
+/// @brief Mark the end of the frame. Every acquired Framebuffer become
+/// available again. The ones unused for too long are deleted.
+/// @see FramebufferPool::SetMaxUnusedFrames
+void FramebufferPool::Recycle() {
+  for (auto& entry : entries_) {
+    entry.in_use = false;
+    entry.unused_frames++;
+  }
+
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [&](const Entry& entry) {
+                                  return entry.unused_frames >
+                                         max_unused_frames_;
+                                }),
+                 entries_.end());
+}
+
+/// @brief Delete every Framebuffer. The ones previously acquired become
+/// invalid.
+void FramebufferPool::Clear() {
+  entries_.clear();
+}
+
+/// @brief Set the number of consecutive frames a Framebuffer can stay unused
+/// before being deleted.
+/// @param max_unused_frames The number of frames.
+void FramebufferPool::SetMaxUnusedFrames(int max_unused_frames) {
+  max_unused_frames_ = max_unused_frames;
+}
+
+/// @brief The number of Framebuffer owned by the pool.
+size_t FramebufferPool::size() const {
+  return entries_.size();
+}
+
+}  // namespace smk
@@ -0,0 +1,111 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <smk/Context.hpp>
+#include <smk/GeometryCache.hpp>
+
+namespace smk {
+
+namespace {
+constexpr size_t default_max_size = 1 << 20;  // NOLINT
+}  // namespace
+
+size_t GeometryCache::KeyHash::operator()(const Key& key) const {
+  // FNV-1a over the bits of the parameters.
+  uint64_t hash = 14695981039346656037ULL;  // NOLINT
+  for (float value : key) {
+    // -0 and +0 compare equal, so they must hash equally.
+    if (value == 0.F) {
+      value = 0.F;
+    }
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    hash = (hash ^ bits) * 1099511628211ULL;  // NOLINT
+  }
+  return size_t(hash);
+}
+
+/// @brief A cache holding up to a million vertices.
+GeometryCache::GeometryCache() : GeometryCache(default_max_size) {}
+
+/// @brief A cache holding up to |max_size| vertices.
+GeometryCache::GeometryCache(size_t max_size) : max_size_(max_size) {}
+
+/// @brief The cache used by smk::Shape generators and smk::Sprite quads. It is
+/// cleared when the OpenGL context is destroyed.
+// static
+GeometryCache& GeometryCache::Default() {
+  // Never destroyed: at exit, the OpenGL context might already be gone.
+  static GeometryCache* cache = [] {
+    auto* instance = new GeometryCache();  // NOLINT
+    AddContextReleaseCallback([instance] { instance->Clear(); });
+    return instance;
+  }();
+  return *cache;
+}
+
+/// @brief Return the VertexArray associated with |key|.
+/// @param key The generator identifier, followed by its parameters. Keys with
+///            infinite or NaN parameters are never cached.
+/// @param build Called to build the VertexArray when it isn't cached.
+VertexArray GeometryCache::Get(const Key& key,
+                               const std::function<VertexArray()>& build) {
+  // A NaN never compares equal to itself, so its key would never be found.
+  for (float value : key) {
+    if (!std::isfinite(value)) {
+      return build();
+    }
+  }
+
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    recency_.splice(recency_.begin(), recency_, it->second.recency);
+    return it->second.vertex_array;
+  }
+
+  // Empty arrays aren't cached: they don't count toward the bound.
+  VertexArray vertex_array = build();
+  if (vertex_array.size() == 0 || vertex_array.size() > max_size_) {
+    return vertex_array;
+  }
+
+  auto inserted = entries_.emplace(key, Entry{vertex_array, {}}).first;
+  recency_.push_front(&inserted->first);
+  inserted->second.recency = recency_.begin();
+  size_ += vertex_array.size();
+  Evict();
+  return vertex_array;
+}
+
+/// @brief Set the maximum number of vertices held by the cache. The least
+/// recently used VertexArray are evicted when it is exceeded.
+/// @param max_size The number of vertices. Zero disables the cache.
+void GeometryCache::SetMaxSize(size_t max_size) {
+  max_size_ = max_size;
+  Evict();
+}
+
+/// @brief Remove every entries.
+void GeometryCache::Clear() {
+  entries_.clear();
+  recency_.clear();
+  size_ = 0;
+}
+
+void GeometryCache::Evict() {
+  while (size_ > max_size_ && !recency_.empty()) {
+    auto it = entries_.find(*recency_.back());
+    recency_.pop_back();
+    if (it == entries_.end()) {
+      continue;
+    }
+    size_ -= it->second.vertex_array.size();
+    entries_.erase(it);
+  }
+}
+
+}  // namespace smk
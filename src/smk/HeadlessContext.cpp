@@ -0,0 +1,48 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <smk/Context.hpp>
+#include <smk/HeadlessContext.hpp>
+#include <smk/OpenGL.hpp>
+#include <utility>
+
+namespace smk {
+
+/// @brief Create an OpenGL context, backed by an invisible window, and make it
+/// current. Throw std::runtime_error on failure.
+HeadlessContext::HeadlessContext() {
+  window_ = CreateContext(1, 1, "smk", /*visible=*/false, /*samples=*/4);
+}
+
+HeadlessContext::~HeadlessContext() {
+  if (window_) {
+    // The static resources belong to this context. Release them while it is
+    // still alive, so that the next context builds its own.
+    glfwMakeContextCurrent(window_);
+    ReleaseContextResources();
+    glfwDestroyWindow(window_);
+    window_ = nullptr;
+  }
+}
+
+/// @brief Make this context the current one for the calling thread.
+void HeadlessContext::MakeCurrent() {
+  glfwMakeContextCurrent(window_);
+}
+
+/// @brief The invisible window handle.
+GLFWwindow* HeadlessContext::window() const {
+  return window_;
+}
+
+HeadlessContext::HeadlessContext(HeadlessContext&& other) noexcept {
+  operator=(std::move(other));
+}
+
+HeadlessContext& HeadlessContext::operator=(HeadlessContext&& other) noexcept {
+  std::swap(window_, other.window_);
+  return *this;
+}
+
+}  // namespace smk
@@ -0,0 +1,945 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <smk/Mesh.hpp>
+#include <unordered_map>
+
+namespace smk {
+
+namespace {
+
+// The cooked mesh format is the header, followed by the raw vertices and
+// indices, in the native byte order.
+struct CookedHeader {
+  char magic[4] = {'S', 'M', 'K', 'M'};
+  uint32_t version = 1;
+  uint32_t vertex_count = 0;
+  uint32_t index_count = 0;
+};
+
+static_assert(sizeof(Vertex3D) == 8 * sizeof(float),
+              "Vertex3D must not contain any padding");
+
+bool ReadFile(const std::string& filename, std::string* content) {
+  FILE* file = fopen(filename.c_str(), "rb");  // NOLINT
+  if (!file) {
+    std::cerr << "File " << filename << " not found" << std::endl;
+    return false;
+  }
+  fseek(file, 0, SEEK_END);              // NOLINT
+  const long size = ftell(file);         // NOLINT
+  fseek(file, 0, SEEK_SET);              // NOLINT
+  content->resize(size_t(std::max(size, 0L)));
+  const size_t read = fread(&(*content)[0], 1, content->size(), file);  // NOLINT
+  fclose(file);                                                         // NOLINT
+  return read == content->size();
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Parse a decimal number in [p, end), like strtod in the C locale. Return the
+// end of the number, or |p| when there is none. The user's locale, which could
+// use a decimal comma, is ignored.
+const char* ParseDecimal(const char* p, const char* end, double* out) {
+  const char* begin = p;
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    ++p;
+  }
+
+  // Keep the 18 first significant digits. The next ones only adjust the
+  // exponent.
+  constexpr uint64_t max_mantissa = 100000000000000000ULL;  // NOLINT
+  uint64_t mantissa = 0;
+  int exponent = 0;
+  bool has_digits = false;
+  for (; p != end && IsDigit(*p); ++p) {
+    has_digits = true;
+    if (mantissa < max_mantissa) {
+      mantissa = mantissa * 10 + uint64_t(*p - '0');  // NOLINT
+    } else {
+      ++exponent;
+    }
+  }
+  if (p != end && *p == '.') {
+    for (++p; p != end && IsDigit(*p); ++p) {
+      has_digits = true;
+      if (mantissa < max_mantissa) {
+        mantissa = mantissa * 10 + uint64_t(*p - '0');  // NOLINT
+        --exponent;
+      }
+    }
+  }
+  if (!has_digits) {
+    return begin;
+  }
+
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    const char* q = p + 1;
+    bool negative_exponent = false;
+    if (q != end && (*q == '+' || *q == '-')) {
+      negative_exponent = *q == '-';
+      ++q;
+    }
+    if (q != end && IsDigit(*q)) {
+      int value = 0;
+      for (; q != end && IsDigit(*q); ++q) {
+        value = std::min(value * 10 + (*q - '0'), 9999);  // NOLINT
+      }
+      exponent += negative_exponent ? -value : value;
+      p = q;
+    }
+  }
+
+  // Dividing by an exact power of ten is more accurate than multiplying by an
+  // inexact negative one.
+  double value = double(mantissa);
+  if (exponent < 0) {
+    value /= std::pow(10.0, -exponent);  // NOLINT
+  } else if (exponent > 0) {
+    value *= std::pow(10.0, exponent);  // NOLINT
+  }
+  *out = negative ? -value : value;
+  return p;
+}
+
+std::string Extension(const std::string& filename) {
+  const size_t dot = filename.find_last_of('.');
+  if (dot == std::string::npos) {
+    return "";
+  }
+  std::string extension = filename.substr(dot + 1);
+  for (char& c : extension) {
+    c = char(std::tolower(c));
+  }
+  return extension;
+}
+
+// Compute smooth normals, as the area weighted average of the adjacent faces.
+// |position_index| identifies the vertices sharing the same position, so that
+// they get the same normal.
+void ComputeNormals(Mesh* mesh, const std::vector<GLuint>& position_index) {
+  std::vector<glm::vec3> normals(mesh->vertices.size(), glm::vec3(0.F));
+  for (size_t i = 0; i + 2 < mesh->indices.size(); i += 3) {
+    const GLuint a = mesh->indices[i + 0];
+    const GLuint b = mesh->indices[i + 1];
+    const GLuint c = mesh->indices[i + 2];
+    const glm::vec3 normal =
+        glm::cross(mesh->vertices[b].space_position -
+                       mesh->vertices[a].space_position,
+                   mesh->vertices[c].space_position -
+                       mesh->vertices[a].space_position);
+    normals[position_index[a]] += normal;
+    normals[position_index[b]] += normal;
+    normals[position_index[c]] += normal;
+  }
+  for (size_t i = 0; i < mesh->vertices.size(); ++i) {
+    const glm::vec3& normal = normals[position_index[i]];
+    const float length = glm::length(normal);
+    mesh->vertices[i].normal =
+        length > 0.F ? normal / length : glm::vec3(0.F, 0.F, 1.F);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Wavefront OBJ.
+// -----------------------------------------------------------------------------
+
+struct ObjCorner {
+  int position = -1;
+  int texture = -1;
+  int normal = -1;
+
+  bool operator==(const ObjCorner& other) const {
+    return position == other.position && texture == other.texture &&
+           normal == other.normal;
+  }
+};
+
+struct ObjCornerHash {
+  size_t operator()(const ObjCorner& corner) const {
+    return size_t(corner.position) * 73856093U ^  // NOLINT
+           size_t(corner.texture) * 19349663U ^   // NOLINT
+           size_t(corner.normal) * 83492791U;     // NOLINT
+  }
+};
+
+const char* SkipSpaces(const char* p) {
+  while (*p == ' ' || *p == '\t') {
+    ++p;
+  }
+  return p;
+}
+
+const char* NextLine(const char* p) {
+  while (*p != '\0' && *p != '\n') {
+    ++p;
+  }
+  return *p == '\n' ? p + 1 : p;
+}
+
+// Parse an OBJ index, converting relative (negative) indices to absolute ones.
+// Return -1 when there is no index.
+int ParseObjIndex(const char** p, size_t size) {
+  char* end = nullptr;
+  const long index = std::strtol(*p, &end, 10);  // NOLINT
+  if (end == *p) {
+    return -1;
+  }
+  *p = end;
+  return index < 0 ? int(long(size) + index) : int(index - 1);
+}
+
+bool ParseObj(const std::string& content, Mesh* mesh) {
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec2> textures;
+  std::vector<glm::vec3> normals;
+  std::vector<ObjCorner> polygon;
+  std::unordered_map<ObjCorner, GLuint, ObjCornerHash> welded;
+  std::vector<GLuint> position_index;
+
+  // Parse up to |size| numbers, without reading past the end of the line.
+  // The missing ones are zero.
+  auto parse_floats = [](const char* p, float* out, int size) {
+    const char* line_end = p;
+    while (*line_end != '\0' && *line_end != '\n') {
+      ++line_end;
+    }
+    for (int i = 0; i < size; ++i) {
+      out[i] = 0.F;
+      while (p != line_end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        ++p;
+      }
+      double value = 0.0;
+      const char* end = ParseDecimal(p, line_end, &value);
+      if (end != p) {
+        out[i] = float(value);
+        p = end;
+      }
+    }
+  };
+
+  const char* p = content.c_str();
+  while (*p != '\0') {
+    p = SkipSpaces(p);
+    if (p[0] == 'v' && (p[1] == ' ' || p[1] == '\t')) {
+      glm::vec3 position;
+      parse_floats(p + 1, &position.x, 3);
+      positions.push_back(position);
+    } else if (p[0] == 'v' && p[1] == 't') {
+      glm::vec2 texture;
+      parse_floats(p + 2, &texture.x, 2);
+      textures.push_back({texture.x, 1.F - texture.y});
+    } else if (p[0] == 'v' && p[1] == 'n') {
+      glm::vec3 normal;
+      parse_floats(p + 2, &normal.x, 3);
+      normals.push_back(normal);
+    } else if (p[0] == 'f' && (p[1] == ' ' || p[1] == '\t')) {
+      polygon.clear();
+      p = SkipSpaces(p + 1);
+      while (*p != '\0' && *p != '\n' && *p != '\r' && *p != '#') {
+        ObjCorner corner;
+        corner.position = ParseObjIndex(&p, positions.size());
+        if (*p == '/') {
+          ++p;
+          corner.texture = ParseObjIndex(&p, textures.size());
+          if (*p == '/') {
+            ++p;
+            corner.normal = ParseObjIndex(&p, normals.size());
+          }
+        }
+        if (corner.position < 0 || corner.position >= int(positions.size()) ||
+            corner.texture >= int(textures.size()) ||
+            corner.normal >= int(normals.size())) {
+          std::cerr << "Invalid OBJ face index" << std::endl;
+          return false;
+        }
+        polygon.push_back(corner);
+        p = SkipSpaces(p);
+      }
+
+      // Triangulate the polygon, using a fan around its first corner.
+      for (size_t i = 2; i < polygon.size(); ++i) {
+        for (const ObjCorner& corner :
+             {polygon[0], polygon[i - 1], polygon[i]}) {
+          auto it = welded.find(corner);
+          if (it == welded.end()) {
+            Vertex3D vertex;
+            vertex.space_position = positions[size_t(corner.position)];
+            if (corner.texture >= 0) {
+              vertex.texture_position = textures[size_t(corner.texture)];
+            }
+            if (corner.normal >= 0) {
+              vertex.normal = normals[size_t(corner.normal)];
+            }
+            it = welded.emplace(corner, GLuint(mesh->vertices.size())).first;
+            mesh->vertices.push_back(vertex);
+            position_index.push_back(GLuint(corner.position));
+          }
+          mesh->indices.push_back(it->second);
+        }
+      }
+    }
+    p = NextLine(p);
+  }
+
+  if (normals.empty()) {
+    // Map the position indices to the first vertex using them.
+    std::vector<GLuint> first(positions.size(), 0);
+    for (size_t i = mesh->vertices.size(); i-- > 0;) {
+      first[position_index[i]] = GLuint(i);
+    }
+    for (GLuint& index : position_index) {
+      index = first[index];
+    }
+    ComputeNormals(mesh, position_index);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// glTF 2.0 binary.
+// -----------------------------------------------------------------------------
+
+// A minimal JSON document, enough to read the glTF descriptions.
+struct Json {
+  enum class Type { Null, Boolean, Number, String, Array, Object };
+  Type type = Type::Null;
+  double number = 0.0;
+  std::string string;
+  std::vector<Json> values;        // The elements of an Array or Object.
+  std::vector<std::string> keys;   // The keys of an Object.
+
+  const Json& operator[](const std::string& key) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (keys[i] == key) {
+        return values[i];
+      }
+    }
+    return Null();
+  }
+
+  const Json& operator[](size_t index) const {
+    return index < values.size() ? values[index] : Null();
+  }
+
+  bool is_null() const { return type == Type::Null; }
+  int Int(int fallback) const {
+    return type == Type::Number ? int(number) : fallback;
+  }
+
+  // Read a size or an offset. A missing value is |fallback|. Return false for
+  // negative, fractional or too large numbers.
+  bool Size(size_t fallback, size_t* out) const {
+    constexpr double max_exact_integer = 9007199254740992.0;  // 2^53.
+    if (is_null()) {
+      *out = fallback;
+      return true;
+    }
+    if (type != Type::Number || !(number >= 0.0) ||
+        number > max_exact_integer || number != std::floor(number)) {
+      return false;
+    }
+    *out = size_t(number);
+    return true;
+  }
+
+  static const Json& Null() {
+    static const Json null;
+    return null;
+  }
+};
+
+class JsonParser {
+ public:
+  JsonParser(const char* begin, const char* end) : p_(begin), end_(end) {}
+
+  bool Parse(Json* json) {
+    SkipSpaces();
+    if (p_ == end_) {
+      return false;
+    }
+    switch (*p_) {
+      case '{':
+        return ParseObject(json);
+      case '[':
+        return ParseArray(json);
+      case '"':
+        json->type = Json::Type::String;
+        return ParseString(&json->string);
+      case 't':
+        json->type = Json::Type::Boolean;
+        json->number = 1.0;
+        return Skip("true");
+      case 'f':
+        json->type = Json::Type::Boolean;
+        return Skip("false");
+      case 'n':
+        return Skip("null");
+      default:
+        return ParseNumber(json);
+    }
+  }
+
+ private:
+  void SkipSpaces() {
+    while (p_ != end_ && std::isspace(static_cast<unsigned char>(*p_))) {
+      ++p_;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipSpaces();
+    if (p_ == end_ || *p_ != c) {
+      return false;
+    }
+    ++p_;
+    return true;
+  }
+
+  bool Skip(const char* word) {
+    const size_t size = std::strlen(word);
+    if (size_t(end_ - p_) < size || std::strncmp(p_, word, size) != 0) {
+      return false;
+    }
+    p_ += size;
+    return true;
+  }
+
+  bool ParseNumber(Json* json) {
+    json->type = Json::Type::Number;
+    const char* end = ParseDecimal(p_, end_, &json->number);
+    if (end == p_) {
+      return false;
+    }
+    p_ = end;
+    return true;
+  }
+
+  bool ParseString(std::string* string) {
+    if (!Consume('"')) {
+      return false;
+    }
+    while (p_ != end_ && *p_ != '"') {
+      if (*p_ == '\\') {
+        if (++p_ == end_) {
+          return false;
+        }
+        switch (*p_) {
+          case 'n': string->push_back('\n'); break;
+          case 't': string->push_back('\t'); break;
+          case 'r': string->push_back('\r'); break;
+          case 'b': string->push_back('\b'); break;
+          case 'f': string->push_back('\f'); break;
+          case 'u':
+            // Unicode escapes aren't used by the glTF keys. Skip them.
+            p_ += std::min<ptrdiff_t>(4, end_ - p_ - 1);
+            string->push_back('?');
+            break;
+          default: string->push_back(*p_); break;
+        }
+        ++p_;
+        continue;
+      }
+      string->push_back(*p_++);
+    }
+    return Consume('"');
+  }
+
+  bool ParseArray(Json* json) {
+    json->type = Json::Type::Array;
+    Consume('[');
+    if (Consume(']')) {
+      return true;
+    }
+    do {
+      json->values.emplace_back();
+      if (!Parse(&json->values.back())) {
+        return false;
+      }
+    } while (Consume(','));
+    return Consume(']');
+  }
+
+  bool ParseObject(Json* json) {
+    json->type = Json::Type::Object;
+    Consume('{');
+    if (Consume('}')) {
+      return true;
+    }
+    do {
+      SkipSpaces();
+      json->keys.emplace_back();
+      json->values.emplace_back();
+      if (!ParseString(&json->keys.back()) || !Consume(':') ||
+          !Parse(&json->values.back())) {
+        return false;
+      }
+    } while (Consume(','));
+    return Consume('}');
+  }
+
+  const char* p_;
+  const char* end_;
+};
+
+constexpr uint32_t glb_magic = 0x46546C67;       // "glTF"
+constexpr uint32_t glb_chunk_json = 0x4E4F534A;  // "JSON"
+constexpr uint32_t glb_chunk_bin = 0x004E4942;   // "BIN\0"
+constexpr int gltf_triangles = 4;
+
+uint32_t ReadUint32(const char* data) {
+  uint32_t value = 0;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+// Read the component of a glTF accessor, converting it to float. Integers are
+// normalized.
+float ReadComponent(const char* data, int component_type) {
+  switch (component_type) {
+    case GL_FLOAT: {
+      float value = 0.F;
+      std::memcpy(&value, data, sizeof(value));
+      return value;
+    }
+    case GL_UNSIGNED_BYTE:
+      return float(uint8_t(*data)) / 255.F;  // NOLINT
+    case GL_UNSIGNED_SHORT: {
+      uint16_t value = 0;
+      std::memcpy(&value, data, sizeof(value));
+      return float(value) / 65535.F;  // NOLINT
+    }
+    default:
+      return 0.F;
+  }
+}
+
+int ComponentSize(int component_type) {
+  switch (component_type) {
+    case GL_UNSIGNED_BYTE:
+      return 1;
+    case GL_UNSIGNED_SHORT:
+      return 2;
+    case GL_UNSIGNED_INT:
+    case GL_FLOAT:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+// Locate the elements of an accessor in the binary chunk. Return false when
+// they don't fit inside.
+bool LocateAccessor(const Json& gltf,
+                    const Json& accessor,
+                    const std::string& bin,
+                    int components,
+                    const char** data,
+                    size_t* stride,
+                    size_t* count) {
+  size_t view_index = 0;
+  if (!accessor["bufferView"].Size(size_t(-1), &view_index)) {
+    return false;
+  }
+  const Json& view = gltf["bufferViews"][view_index];
+  const int component_type = accessor["componentType"].Int(0);
+  const size_t element_size =
+      size_t(ComponentSize(component_type)) * size_t(components);
+  if (view.is_null() || element_size == 0 || view["buffer"].Int(0) != 0) {
+    return false;
+  }
+
+  size_t view_offset = 0;
+  size_t accessor_offset = 0;
+  if (!view["byteOffset"].Size(0, &view_offset) ||
+      !accessor["byteOffset"].Size(0, &accessor_offset) ||
+      !view["byteStride"].Size(element_size, stride) ||
+      !accessor["count"].Size(0, count)) {
+    return false;
+  }
+  if (*stride == 0) {
+    *stride = element_size;  // Tightly packed.
+  }
+  if (*stride < element_size) {
+    return false;
+  }
+
+  // Check that every element fits, without overflowing.
+  if (view_offset > bin.size() || accessor_offset > bin.size() - view_offset) {
+    return false;
+  }
+  const size_t offset = view_offset + accessor_offset;
+  *data = bin.data() + offset;
+  if (*count == 0) {
+    return true;
+  }
+  const size_t available = bin.size() - offset;
+  return element_size <= available &&
+         *count - 1 <= (available - element_size) / *stride;
+}
+
+bool ReadAttribute(const Json& gltf,
+                   const Json& accessor,
+                   const std::string& bin,
+                   int components,
+                   std::vector<float>* out) {
+  const char* data = nullptr;
+  size_t stride = 0;
+  size_t count = 0;
+  if (!LocateAccessor(gltf, accessor, bin, components, &data, &stride,
+                      &count)) {
+    return false;
+  }
+  const int component_type = accessor["componentType"].Int(0);
+  const int component_size = ComponentSize(component_type);
+  out->resize(count * size_t(components));
+  for (size_t i = 0; i < count; ++i) {
+    for (int c = 0; c < components; ++c) {
+      (*out)[i * size_t(components) + size_t(c)] = ReadComponent(
+          data + i * stride + size_t(c * component_size), component_type);
+    }
+  }
+  return true;
+}
+
+bool ReadIndices(const Json& gltf,
+                 const Json& accessor,
+                 const std::string& bin,
+                 GLuint base,
+                 std::vector<GLuint>* out) {
+  const char* data = nullptr;
+  size_t stride = 0;
+  size_t count = 0;
+  if (!LocateAccessor(gltf, accessor, bin, 1, &data, &stride, &count)) {
+    return false;
+  }
+  const int component_type = accessor["componentType"].Int(0);
+  for (size_t i = 0; i < count; ++i) {
+    const char* element = data + i * stride;
+    GLuint index = 0;
+    switch (component_type) {
+      case GL_UNSIGNED_BYTE:
+        index = uint8_t(*element);
+        break;
+      case GL_UNSIGNED_SHORT: {
+        uint16_t value = 0;
+        std::memcpy(&value, element, sizeof(value));
+        index = value;
+        break;
+      }
+      default:
+        index = ReadUint32(element);
+        break;
+    }
+    out->push_back(base + index);
+  }
+  return true;
+}
+
+bool ParseGlb(const std::string& content, Mesh* mesh) {
+  constexpr size_t header_size = 12;
+  constexpr size_t chunk_header_size = 8;
+  if (content.size() < header_size || ReadUint32(&content[0]) != glb_magic ||
+      ReadUint32(&content[4]) != 2) {
+    std::cerr << "Not a glTF 2.0 binary file" << std::endl;
+    return false;
+  }
+
+  // Locate the JSON and BIN chunks.
+  const char* json_begin = nullptr;
+  const char* json_end = nullptr;
+  std::string bin;
+  size_t offset = header_size;
+  while (offset + chunk_header_size <= content.size()) {
+    const size_t length = ReadUint32(&content[offset]);
+    const uint32_t type = ReadUint32(&content[offset + 4]);
+    const size_t begin = offset + chunk_header_size;
+    if (begin + length > content.size()) {
+      break;
+    }
+    if (type == glb_chunk_json) {
+      json_begin = content.data() + begin;
+      json_end = json_begin + length;
+    } else if (type == glb_chunk_bin) {
+      bin = content.substr(begin, length);
+    }
+    offset = begin + length;
+  }
+
+  Json gltf;
+  if (!json_begin || !JsonParser(json_begin, json_end).Parse(&gltf)) {
+    std::cerr << "Invalid glTF description" << std::endl;
+    return false;
+  }
+
+  std::vector<float> positions;
+  std::vector<float> normals;
+  std::vector<float> textures;
+  std::vector<GLuint> position_index;
+  bool missing_normals = false;
+  for (const Json& gltf_mesh : gltf["meshes"].values) {
+    for (const Json& primitive : gltf_mesh["primitives"].values) {
+      if (primitive["mode"].Int(gltf_triangles) != gltf_triangles) {
+        continue;
+      }
+      const Json& attributes = primitive["attributes"];
+      const Json& accessors = gltf["accessors"];
+      if (!ReadAttribute(gltf,
+                         accessors[size_t(attributes["POSITION"].Int(-1))],
+                         bin, 3, &positions)) {
+        std::cerr << "Invalid glTF POSITION attribute" << std::endl;
+        return false;
+      }
+      const size_t count = positions.size() / 3;
+
+      normals.clear();
+      textures.clear();
+      if (!attributes["NORMAL"].is_null()) {
+        ReadAttribute(gltf, accessors[size_t(attributes["NORMAL"].Int(-1))],
+                      bin, 3, &normals);
+      }
+      if (!attributes["TEXCOORD_0"].is_null()) {
+        ReadAttribute(gltf,
+                      accessors[size_t(attributes["TEXCOORD_0"].Int(-1))],
+                      bin, 2, &textures);
+      }
+      missing_normals |= normals.size() != 3 * count;
+
+      const auto base = GLuint(mesh->vertices.size());
+      for (size_t i = 0; i < count; ++i) {
+        Vertex3D vertex;
+        vertex.space_position = {positions[3 * i + 0], positions[3 * i + 1],
+                                 positions[3 * i + 2]};
+        if (normals.size() == 3 * count) {
+          vertex.normal = {normals[3 * i + 0], normals[3 * i + 1],
+                           normals[3 * i + 2]};
+        }
+        if (textures.size() == 2 * count) {
+          vertex.texture_position = {textures[2 * i + 0],
+                                     textures[2 * i + 1]};
+        }
+        mesh->vertices.push_back(vertex);
+        position_index.push_back(base + GLuint(i));
+      }
+
+      const size_t first_index = mesh->indices.size();
+      if (primitive["indices"].is_null()) {
+        for (size_t i = 0; i < count; ++i) {
+          mesh->indices.push_back(base + GLuint(i));
+        }
+      } else if (!ReadIndices(gltf,
+                              accessors[size_t(primitive["indices"].Int(-1))],
+                              bin, base, &mesh->indices)) {
+        std::cerr << "Invalid glTF indices" << std::endl;
+        return false;
+      }
+      for (size_t i = first_index; i < mesh->indices.size(); ++i) {
+        if (mesh->indices[i] >= mesh->vertices.size()) {
+          std::cerr << "Invalid glTF indices" << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+
+  if (missing_normals) {
+    ComputeNormals(mesh, position_index);
+  }
+  return true;
+}
+
+bool ModificationTime(const std::string& filename, time_t* time) {
+  struct stat info = {};
+  if (stat(filename.c_str(), &info) != 0) {
+    return false;
+  }
+  *time = info.st_mtime;
+  return true;
+}
+
+}  // namespace
+
+/// @brief Load a mesh. The format is deduced from the file extension: .obj,
+/// .glb or .smkmesh.
+/// @param filename The file to be loaded.
+/// @return The mesh. It is empty on error.
+// static
+Mesh Mesh::Load(const std::string& filename) {
+  const std::string extension = Extension(filename);
+  if (extension == "obj") {
+    return LoadObj(filename);
+  }
+  if (extension == "glb") {
+    return LoadGlb(filename);
+  }
+  if (extension == "smkmesh") {
+    return LoadCooked(filename);
+  }
+  std::cerr << "Unsupported mesh format: " << filename << std::endl;
+  return {};
+}
+
+/// @brief Load a Wavefront OBJ file.
+/// @param filename The file to be loaded.
+/// @return The mesh. It is empty on error.
+// static
+Mesh Mesh::LoadObj(const std::string& filename) {
+  std::string content;
+  Mesh mesh;
+  if (!ReadFile(filename, &content) || !ParseObj(content, &mesh)) {
+    std::cerr << "Failed to load " << filename << std::endl;
+    return {};
+  }
+  return mesh;
+}
+
+/// @brief Load a glTF 2.0 binary file.
+/// @param filename The file to be loaded.
+/// @return The mesh. It is empty on error.
+// static
+Mesh Mesh::LoadGlb(const std::string& filename) {
+  std::string content;
+  Mesh mesh;
+  if (!ReadFile(filename, &content) || !ParseGlb(content, &mesh)) {
+    std::cerr << "Failed to load " << filename << std::endl;
+    return {};
+  }
+  return mesh;
+}
+
+/// @brief Load a mesh written by Mesh::Save. The vertices and indices are read
+/// directly into their final buffers.
+/// @param filename The file to be loaded.
+/// @return The mesh. It is empty on error.
+// static
+Mesh Mesh::LoadCooked(const std::string& filename) {
+  FILE* file = fopen(filename.c_str(), "rb");  // NOLINT
+  if (!file) {
+    std::cerr << "File " << filename << " not found" << std::endl;
+    return {};
+  }
+
+  fseek(file, 0, SEEK_END);                      // NOLINT
+  const auto file_size = uint64_t(ftell(file));  // NOLINT
+  fseek(file, 0, SEEK_SET);                      // NOLINT
+
+  Mesh mesh;
+  CookedHeader header;
+  const CookedHeader expected;
+  bool valid = fread(&header, sizeof(header), 1, file) == 1 &&  // NOLINT
+               std::memcmp(header.magic, expected.magic, 4) == 0 &&
+               header.version == expected.version;
+
+  // Check the counts against the file size before allocating anything.
+  const uint64_t expected_size =
+      sizeof(header) + uint64_t(header.vertex_count) * sizeof(Vertex3D) +
+      uint64_t(header.index_count) * sizeof(GLuint);
+  valid = valid && file_size == expected_size;
+  if (valid) {
+    mesh.vertices.resize(header.vertex_count);
+    mesh.indices.resize(header.index_count);
+    valid = fread(mesh.vertices.data(), sizeof(Vertex3D),  // NOLINT
+                  mesh.vertices.size(), file) == mesh.vertices.size() &&
+            fread(mesh.indices.data(), sizeof(GLuint),  // NOLINT
+                  mesh.indices.size(), file) == mesh.indices.size();
+  }
+  fclose(file);  // NOLINT
+
+  // An index out of range would make the GPU read outside of the vertices.
+  valid = valid && std::all_of(mesh.indices.begin(), mesh.indices.end(),
+                               [&](GLuint index) {
+                                 return index < header.vertex_count;
+                               });
+
+  if (!valid) {
+    std::cerr << "Invalid cooked mesh " << filename << std::endl;
+    return {};
+  }
+  return mesh;
+}
+
+/// @brief Load a mesh, using a cooked version of it when it is up to date.
+///
+/// The cooked version is used when it is more recent than |filename|, or when
+/// |filename| doesn't exist. Otherwise |filename| is loaded, and the cooked
+/// version is written for the next time.
+/// @param filename The OBJ or glTF file.
+/// @param cooked_filename The cooked version of |filename|.
+/// @return The mesh. It is empty on error.
+// static
+Mesh Mesh::LoadCached(const std::string& filename,
+                      const std::string& cooked_filename) {
+  time_t source_time = 0;
+  time_t cooked_time = 0;
+  const bool has_source = ModificationTime(filename, &source_time);
+  const bool has_cooked = ModificationTime(cooked_filename, &cooked_time);
+  if (has_cooked && (!has_source || cooked_time >= source_time)) {
+    Mesh mesh = LoadCooked(cooked_filename);
+    if (!mesh.empty() || !has_source) {
+      return mesh;
+    }
+  }
+
+  Mesh mesh = Load(filename);
+  if (!mesh.empty()) {
+    mesh.Save(cooked_filename);
+  }
+  return mesh;
+}
+
+/// @brief Write the mesh in the cooked format, for Mesh::LoadCooked.
+/// @param cooked_filename The file to be written.
+/// @return Whether the file was written successfully.
+bool Mesh::Save(const std::string& cooked_filename) const {
+  FILE* file = fopen(cooked_filename.c_str(), "wb");  // NOLINT
+  if (!file) {
+    std::cerr << "Failed to write " << cooked_filename << std::endl;
+    return false;
+  }
+
+  CookedHeader header;
+  header.vertex_count = uint32_t(vertices.size());
+  header.index_count = uint32_t(indices.size());
+  bool valid = fwrite(&header, sizeof(header), 1, file) == 1 &&  // NOLINT
+               fwrite(vertices.data(), sizeof(Vertex3D),           // NOLINT
+                      vertices.size(), file) == vertices.size() &&
+               fwrite(indices.data(), sizeof(GLuint),  // NOLINT
+                      indices.size(), file) == indices.size();
+  valid &= fclose(file) == 0;  // NOLINT
+
+  if (!valid) {
+    std::cerr << "Failed to write " << cooked_filename << std::endl;
+    std::remove(cooked_filename.c_str());
+  }
+  return valid;
+}
+
+/// @brief Upload the mesh to the GPU.
+VertexArray Mesh::vertex_array() const {
+  return VertexArray(vertices, indices);
+}
+
+/// @brief Upload the mesh to the GPU, and return a drawable using it.
+Transformable3D Mesh::transformable() const {
+  Transformable3D transformable;
+  transformable.SetVertexArray(vertex_array());
+  return transformable;
+}
+
+}  // namespace smk
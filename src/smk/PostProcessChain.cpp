@@ -0,0 +1,275 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <smk/Color.hpp>
+#include <smk/Context.hpp>
+#include <smk/PostProcessChain.hpp>
+#include <smk/RenderState.hpp>
+#include <smk/RenderTarget.hpp>
+#include <sstream>
+#include <string>
+
+namespace smk {
+
+namespace {
+
+// Build the fragment shader of one direction of a gaussian blur of standard
+// deviation |sigma|. Consecutive taps are merged into a single one, placed in
+// between them, so that the hardware linear filtering computes their weighted
+// sum. This halves the number of texture fetches.
+std::string GaussianBlurShader(float sigma) {
+  sigma = std::max(sigma, 0.1F);  // NOLINT
+  const int radius = std::max(1, int(std::ceil(3.F * sigma)));  // NOLINT
+
+  std::vector<float> weights;
+  float sum = 0.F;
+  for (int i = 0; i <= radius; ++i) {
+    weights.push_back(std::exp(-float(i * i) / (2.F * sigma * sigma)));
+    sum += (i == 0 ? 1.F : 2.F) * weights.back();
+  }
+  for (auto& weight : weights) {
+    weight /= sum;
+  }
+
+  std::vector<float> tap_offsets = {0.F};
+  std::vector<float> tap_weights = {weights[0]};
+  for (int i = 1; i <= radius; i += 2) {
+    const float w1 = weights[i];
+    const float w2 = i + 1 <= radius ? weights[i + 1] : 0.F;
+    tap_weights.push_back(w1 + w2);
+    tap_offsets.push_back((float(i) * w1 + float(i + 1) * w2) / (w1 + w2));
+  }
+
+  // GLSL literals don't depend on the user's locale. Print every significant
+  // digit, and always a decimal point, so that they are parsed as floats.
+  auto to_array = [](const std::vector<float>& values) {
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out << std::showpoint
+        << std::setprecision(std::numeric_limits<float>::max_digits10);
+    out << "float[" << values.size() << "](";
+    for (size_t i = 0; i < values.size(); ++i) {
+      out << (i ? ", " : "") << values[i];
+    }
+    out << ")";
+    return out.str();
+  };
+
+  const std::string taps = std::to_string(tap_offsets.size());
+  return R"(
+    in vec2 f_texture_position;
+    uniform sampler2D texture_0;
+    uniform vec4 color;
+    uniform vec2 direction;
+    out vec4 out_color;
+
+    const float offsets[)" +
+         taps + "] = " + to_array(tap_offsets) + R"(;
+    const float weights[)" +
+         taps + "] = " + to_array(tap_weights) + R"(;
+
+    void main() {
+      vec4 sum = texture(texture_0, f_texture_position) * weights[0];
+      for (int i = 1; i < )" +
+         taps + R"(; ++i) {
+        vec2 offset = direction * offsets[i];
+        sum += texture(texture_0, f_texture_position + offset) * weights[i];
+        sum += texture(texture_0, f_texture_position - offset) * weights[i];
+      }
+      out_color = sum * color;
+    }
+  )";
+}
+
+const char* const kVertexShader = R"(
+  layout(location = 0) in vec2 space_position;
+  layout(location = 1) in vec2 texture_position;
+
+  out vec2 f_texture_position;
+
+  void main() {
+    f_texture_position = texture_position;
+    gl_Position = vec4(space_position, 0.0, 1.0);
+  }
+)";
+
+// Copy the input into the output. Used by an empty chain.
+ShaderProgram& CopyShaderProgram() {
+  static ContextResource<ShaderProgram> shader_program([] {
+    auto vertex_shader = Shader::FromString(kVertexShader, GL_VERTEX_SHADER);
+    auto fragment_shader = Shader::FromString(R"(
+      in vec2 f_texture_position;
+      uniform sampler2D texture_0;
+      uniform vec4 color;
+      out vec4 out_color;
+
+      void main() {
+        out_color = texture(texture_0, f_texture_position) * color;
+      }
+    )",
+                                              GL_FRAGMENT_SHADER);
+    return LinkShaderProgram(vertex_shader, fragment_shader,
+                             /*textured=*/true);
+  });
+  return shader_program.Get();
+}
+
+}  // namespace
+
+/// @brief An empty PostProcessChain.
+PostProcessChain::PostProcessChain() {
+  vertex_shader_ = Shader::FromString(kVertexShader, GL_VERTEX_SHADER);
+
+  framebuffer_option_.internal_format = GL_RGBA8;
+  framebuffer_option_.format = GL_RGBA;
+  framebuffer_option_.depth_stencil = false;
+}
+
+/// @brief Add a pass at the end of the chain.
+/// @param fragment_shader The fragment shader of the pass.
+/// @param scale The resolution of the pass, relative to the chain's input. It
+///              is ignored for the last pass, which is drawn directly into the
+///              output.
+/// @return The ShaderProgram of the pass. Its uniforms can be modified.
+ShaderProgram PostProcessChain::AddPass(const Shader& fragment_shader,
+                                        float scale) {
+  return AddPass(fragment_shader, scale, nullptr);
+}
+
+/// @brief Add a pass at the end of the chain.
+/// @param fragment_shader The fragment shader of the pass.
+/// @param scale The resolution of the pass, relative to the chain's input. It
+///              is ignored for the last pass, which is drawn directly into the
+///              output.
+/// @param set_uniforms Called before drawing the pass, with its ShaderProgram
+///                     bound, the texture it reads from and the resolution of
+///                     the pass.
+/// @return The ShaderProgram of the pass. Its uniforms can be modified.
+ShaderProgram PostProcessChain::AddPass(const Shader& fragment_shader,
+                                        float scale,
+                                        SetUniforms set_uniforms) {
+  Pass pass;
+  pass.fragment_shader = fragment_shader;
+  pass.shader_program = LinkShaderProgram(vertex_shader_, pass.fragment_shader,
+                                          /*textured=*/true);
+  pass.scale = scale;
+  pass.set_uniforms = std::move(set_uniforms);
+
+  passes_.push_back(std::move(pass));
+  return passes_.back().shader_program;
+}
+
+/// @brief Add a separable gaussian blur. It is made of an horizontal and a
+/// vertical pass.
+/// @param sigma The standard deviation of the gaussian, in pixels of the pass.
+/// @param scale The resolution of the passes, relative to the chain's input.
+///              Blurring at a lower resolution is cheaper.
+///
+/// Both passes step by one pixel of the pass's resolution, whatever the size of
+/// the texture they read from, so the blur is the same in both directions.
+void PostProcessChain::AddGaussianBlur(float sigma, float scale) {
+  auto fragment_shader =
+      Shader::FromString(GaussianBlurShader(sigma), GL_FRAGMENT_SHADER);
+  AddPass(fragment_shader, scale,
+          [](ShaderProgram& shader_program, const Texture& /*input*/,
+             const glm::vec2& resolution) {
+            shader_program.SetUniform("direction",
+                                      glm::vec2(1.F / resolution.x, 0.F));
+          });
+  AddPass(fragment_shader, scale,
+          [](ShaderProgram& shader_program, const Texture& /*input*/,
+             const glm::vec2& resolution) {
+            shader_program.SetUniform("direction",
+                                      glm::vec2(0.F, 1.F / resolution.y));
+          });
+}
+
+/// @brief Run every passes on |input|. The last one is drawn into |output|,
+/// replacing its content. An empty chain copies |input| into |output|.
+/// @param input The texture read by the first pass.
+/// @param output Where the result is drawn.
+void PostProcessChain::Apply(const Texture& input, RenderTarget& output) {
+  Apply(input, output, BlendMode::Replace);
+}
+
+/// @brief Run every passes on |input|. The last one is drawn into |output|.
+/// An empty chain draws |input| into |output|.
+/// @param input The texture read by the first pass.
+/// @param output Where the result is drawn.
+/// @param blend_mode How the result is mixed into |output|. For instance
+///                   BlendMode::Add for a bloom effect.
+void PostProcessChain::Apply(const Texture& input,
+                             RenderTarget& output,
+                             const BlendMode& blend_mode) {
+  if (passes_.empty()) {
+    RenderState state;
+    state.shader_program = CopyShaderProgram();
+    state.texture = input;
+    state.color = Color::White;
+    state.blend_mode = blend_mode;
+    output.DrawFullScreen(state);
+    return;
+  }
+
+  Texture source = input;
+  Framebuffer* previous = nullptr;
+  for (size_t i = 0; i < passes_.size(); ++i) {
+    Pass& pass = passes_[i];
+    const bool last = i + 1 == passes_.size();
+
+    const int width = std::max(1, int(float(input.width()) * pass.scale));
+    const int height = std::max(1, int(float(input.height()) * pass.scale));
+
+    RenderTarget* target = &output;
+    Framebuffer* framebuffer = nullptr;
+    if (!last) {
+      framebuffer =
+          &framebuffer_pool_.Acquire(width, height, framebuffer_option_);
+      target = framebuffer;
+    }
+
+    RenderState state;
+    state.shader_program = pass.shader_program;
+    state.texture = source;
+    state.color = Color::White;
+    state.blend_mode = last ? blend_mode : BlendMode::Replace;
+    if (pass.set_uniforms) {
+      state.shader_program.Use();
+      pass.set_uniforms(state.shader_program, source,
+                        glm::vec2(float(width), float(height)));
+    }
+    target->DrawFullScreen(state);
+
+    // Ping-pong: the previous Framebuffer can be written by the next pass.
+    if (previous) {
+      framebuffer_pool_.Release(*previous);
+    }
+    previous = framebuffer;
+    if (framebuffer) {
+      source = framebuffer->color_texture();
+    }
+  }
+
+  framebuffer_pool_.Recycle();
+}
+
+/// @brief Set the format of the intermediate Framebuffer.
+/// @param option The Framebuffer options. The depth-stencil buffer is useless
+///               for full-screen passes and can be disabled.
+void PostProcessChain::SetFramebufferOption(
+    const Framebuffer::Option& option) {
+  framebuffer_option_ = option;
+}
+
+/// @brief The number of passes.
+size_t PostProcessChain::size() const {
+  return passes_.size();
+}
+
+}  // namespace smk
@@ -0,0 +1,413 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <smk/Color.hpp>
+#include <smk/Profiler.hpp>
+#include <smk/RenderTarget.hpp>
+#include <smk/Shape.hpp>
+#include <smk/Text.hpp>
+#include <sstream>
+
+namespace smk {
+extern bool g_timer_query;  // NOLINT
+
+namespace {
+
+// Past this number of frames waiting for their GPU timestamps, the oldest one
+// is read, even if this means waiting for the GPU.
+constexpr size_t max_pending_frames = 4;
+
+constexpr size_t default_history = 120;
+
+void EscapeJson(std::ostream& out, const std::string& string) {
+  for (char c : string) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) >= 0x20) {  // NOLINT
+          out << c;
+        }
+        break;
+    }
+  }
+}
+
+void WriteStatistics(std::ostream& out, const RenderStatistics& statistics) {
+  out << R"("args":{"draw_calls":)" << statistics.draw_calls        //
+      << R"(,"vertices":)" << statistics.vertices                    //
+      << R"(,"triangles":)" << statistics.triangles                  //
+      << R"(,"state_changes":)" << statistics.state_changes          //
+      << R"(,"shader_switches":)" << statistics.shader_switches      //
+      << R"(,"texture_binds":)" << statistics.texture_binds          //
+      << R"(,"blend_changes":)" << statistics.blend_changes          //
+      << R"(,"uniform_uploads":)" << statistics.uniform_uploads      //
+      << R"(,"buffer_creations":)" << statistics.buffer_creations    //
+      << R"(,"texture_creations":)" << statistics.texture_creations  //
+      << R"(,"bytes_uploaded":)" << statistics.bytes_uploaded << "}";
+}
+
+// A "complete" event of the Chrome trace format. The times are in seconds.
+void WriteEvent(std::ostream& out,
+                const std::string& name,
+                int thread,
+                double begin,
+                double duration,
+                const RenderStatistics& statistics) {
+  out << R"(,{"name":")";
+  EscapeJson(out, name);
+  out << R"(","ph":"X","pid":1,"tid":)" << thread  //
+      << R"(,"ts":)" << begin * 1e6                 // NOLINT
+      << R"(,"dur":)" << duration * 1e6 << ",";     // NOLINT
+  WriteStatistics(out, statistics);
+  out << "}";
+}
+
+std::string FormatMilliseconds(double seconds) {
+  char buffer[32];  // NOLINT
+  std::snprintf(buffer, sizeof(buffer), "%.2fms", seconds * 1e3);  // NOLINT
+  return buffer;
+}
+
+}  // namespace
+
+Profiler::ScopeGuard::~ScopeGuard() {
+  if (profiler_) {
+    profiler_->EndScope();
+  }
+}
+
+Profiler::ScopeGuard::ScopeGuard(ScopeGuard&& other) noexcept
+    : profiler_(other.profiler_) {
+  other.profiler_ = nullptr;
+}
+
+/// @brief A Profiler keeping the last 120 frames.
+Profiler::Profiler() : Profiler(default_history) {}
+
+/// @brief A Profiler.
+/// @param history The number of completed frames kept.
+Profiler::Profiler(size_t history)
+    : history_(history), start_(std::chrono::steady_clock::now()) {}
+
+Profiler::~Profiler() {
+  if (!all_queries_.empty()) {
+    glDeleteQueries(GLsizei(all_queries_.size()), all_queries_.data());
+  }
+}
+
+/// @brief Enable or disable the profiler. It is enabled by default.
+void Profiler::SetEnabled(bool enabled) {
+  enabled_ = enabled;
+}
+
+/// @brief Start measuring a new frame.
+void Profiler::BeginFrame() {
+  if (!enabled_) {
+    return;
+  }
+  if (in_frame_) {
+    EndFrame();
+  }
+
+  in_frame_ = true;
+  current_ = PendingFrame();
+  current_.frame.index = frame_index_++;
+  current_.frame.cpu_begin = Now();
+  current_.frame.statistics = RenderStatistics::Total();
+  current_.frame_queries[0] = AcquireQuery();
+  Timestamp(current_.frame_queries[0]);
+}
+
+/// @brief Complete the current frame. Its results are available once the GPU
+/// has executed it, usually a few frames later.
+void Profiler::EndFrame() {
+  if (!in_frame_) {
+    return;
+  }
+  while (!open_scopes_.empty()) {
+    EndScope();
+  }
+
+  in_frame_ = false;
+  current_.frame.cpu_duration = Now() - current_.frame.cpu_begin;
+  current_.frame.statistics =
+      RenderStatistics::Total() - current_.frame.statistics;
+  current_.frame_queries[1] = AcquireQuery();
+  Timestamp(current_.frame_queries[1]);
+
+  pending_.push_back(std::move(current_));
+  Collect(pending_.size() > max_pending_frames);
+}
+
+/// @brief Start measuring a scope. Scopes can be nested. They must be ended in
+/// the reverse order. This does nothing outside of a frame.
+/// @param name The name of the scope.
+void Profiler::BeginScope(const std::string& name) {
+  if (!in_frame_) {
+    return;
+  }
+
+  ScopeResult scope;
+  scope.name = name;
+  scope.depth = int(open_scopes_.size());
+  scope.cpu_begin = Now();
+  scope.statistics = RenderStatistics::Total();
+  open_scopes_.push_back(current_.frame.scopes.size());
+  current_.frame.scopes.push_back(std::move(scope));
+
+  const GLuint begin = AcquireQuery();
+  Timestamp(begin);
+  current_.scope_queries.push_back(begin);
+  current_.scope_queries.push_back(0);
+}
+
+/// @brief End the last scope started.
+void Profiler::EndScope() {
+  if (!in_frame_ || open_scopes_.empty()) {
+    return;
+  }
+
+  const size_t index = open_scopes_.back();
+  open_scopes_.pop_back();
+  ScopeResult& scope = current_.frame.scopes[index];
+  scope.cpu_duration = Now() - scope.cpu_begin;
+  scope.statistics = RenderStatistics::Total() - scope.statistics;
+
+  const GLuint end = AcquireQuery();
+  Timestamp(end);
+  current_.scope_queries[2 * index + 1] = end;
+}
+
+/// @brief Measure a scope, until the returned object is destroyed.
+/// @param name The name of the scope.
+Profiler::ScopeGuard Profiler::Scope(const std::string& name) {
+  BeginScope(name);
+  return ScopeGuard(this);
+}
+
+double Profiler::Now() const {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start_)
+      .count();
+}
+
+// Return 0 when the GPU timestamps aren't supported.
+GLuint Profiler::AcquireQuery() {
+  if (!g_timer_query) {
+    return 0;
+  }
+  if (free_queries_.empty()) {
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    all_queries_.push_back(query);
+    return query;
+  }
+  const GLuint query = free_queries_.back();
+  free_queries_.pop_back();
+  return query;
+}
+
+void Profiler::Timestamp(GLuint query) {
+#ifndef __EMSCRIPTEN__
+  if (query) {
+    glQueryCounter(query, GL_TIMESTAMP);
+  }
+#endif
+}
+
+// Move the frames whose GPU timestamps are available to |frames_|. When |wait|
+// is set, the oldest one is read even if the GPU hasn't reached it yet.
+void Profiler::Collect(bool wait) {
+  while (!pending_.empty()) {
+    PendingFrame& pending = pending_.front();
+    Frame& frame = pending.frame;
+
+#ifndef __EMSCRIPTEN__
+    if (pending.frame_queries[1]) {
+      // The queries complete in order. The last one of the frame is enough.
+      GLint available = GL_FALSE;
+      glGetQueryObjectiv(pending.frame_queries[1], GL_QUERY_RESULT_AVAILABLE,
+                         &available);
+      if (!available && !wait) {
+        return;
+      }
+
+      auto read = [](GLuint query) {
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+        return nanoseconds;
+      };
+      const GLuint64 frame_begin = read(pending.frame_queries[0]);
+      const GLuint64 frame_end = read(pending.frame_queries[1]);
+      frame.gpu_duration = double(frame_end - frame_begin) * 1e-9;  // NOLINT
+      for (size_t i = 0; i < frame.scopes.size(); ++i) {
+        const GLuint64 begin = read(pending.scope_queries[2 * i + 0]);
+        const GLuint64 end = read(pending.scope_queries[2 * i + 1]);
+        frame.scopes[i].gpu_begin = double(begin - frame_begin) * 1e-9;  // NOLINT
+        frame.scopes[i].gpu_duration = double(end - begin) * 1e-9;  // NOLINT
+      }
+
+      free_queries_.push_back(pending.frame_queries[0]);
+      free_queries_.push_back(pending.frame_queries[1]);
+      free_queries_.insert(free_queries_.end(), pending.scope_queries.begin(),
+                           pending.scope_queries.end());
+    }
+#endif
+
+    wait = false;
+    frames_.push_back(std::move(frame));
+    pending_.pop_front();
+    while (frames_.size() > history_) {
+      frames_.pop_front();
+    }
+  }
+}
+
+/// @brief Export the completed frames in the Chrome trace event format. The
+/// CPU scopes are on the first thread, the GPU ones on the second.
+std::string Profiler::ChromeTrace() const {
+  std::ostringstream out;
+  out << std::fixed;
+  out.precision(3);
+  out << R"({"traceEvents":[)";
+  out << R"({"name":"thread_name","ph":"M","pid":1,"tid":1,)"
+      << R"("args":{"name":"CPU"}})";
+  out << R"(,{"name":"thread_name","ph":"M","pid":1,"tid":2,)"
+      << R"("args":{"name":"GPU"}})";
+  for (const Frame& frame : frames_) {
+    const std::string name = "Frame " + std::to_string(frame.index);
+    WriteEvent(out, name, 1, frame.cpu_begin, frame.cpu_duration,
+               frame.statistics);
+    if (frame.gpu_duration >= 0.0) {
+      WriteEvent(out, name, 2, frame.cpu_begin, frame.gpu_duration,
+                 frame.statistics);
+    }
+    for (const ScopeResult& scope : frame.scopes) {
+      WriteEvent(out, scope.name, 1, scope.cpu_begin, scope.cpu_duration,
+                 scope.statistics);
+      // The GPU timeline is aligned with the start of the frame on the CPU.
+      if (scope.gpu_duration >= 0.0) {
+        WriteEvent(out, scope.name, 2, frame.cpu_begin + scope.gpu_begin,
+                   scope.gpu_duration, scope.statistics);
+      }
+    }
+  }
+  out << "]}";
+  return out.str();
+}
+
+/// @brief Write Profiler::ChromeTrace into a file.
+/// @return Whether the file was written successfully.
+bool Profiler::SaveChromeTrace(const std::string& filename) const {
+  std::ofstream file(filename);
+  file << ChromeTrace();
+  if (!file) {
+    std::cerr << "Failed to write " << filename << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/// @brief Draw the scopes of the last completed frame.
+///
+/// This sets the View of |target| to its size in pixels. The overlay is drawn
+/// in the top left corner.
+void Profiler::DrawOverlay(RenderTarget& target) {
+  Overlay(target, nullptr);
+}
+
+/// @brief Draw the scopes of the last completed frame, with their names and
+/// durations.
+///
+/// This sets the View of |target| to its size in pixels. The overlay is drawn
+/// in the top left corner.
+void Profiler::DrawOverlay(RenderTarget& target, Font& font) {
+  Overlay(target, &font);
+}
+
+void Profiler::Overlay(RenderTarget& target, Font* font) {
+  if (frames_.empty()) {
+    return;
+  }
+  const Frame& frame = frames_.back();
+
+  View view;
+  view.SetCenter(float(target.width()) * 0.5F,    // NOLINT
+                 float(target.height()) * 0.5F);  // NOLINT
+  view.SetSize(float(target.width()), float(target.height()));
+  target.SetView(view);
+
+  // A frame at 60 fps spans the whole bar.
+  constexpr float margin = 10.F;
+  constexpr float row_height = 20.F;
+  constexpr float bar_height = 6.F;
+  constexpr float bar_width = 300.F;
+  constexpr float indent = 10.F;
+  constexpr double reference = 1.0 / 60.0;
+  const float label_width = font ? 250.F : 0.F;  // NOLINT
+
+  RenderState state;
+  state.shader_program = target.shader_program_2d();
+  state.color = Color::White;
+  state.blend_mode = BlendMode::Alpha;
+
+  auto rectangle = [&](float x, float y, float width, float height,
+                       const glm::vec4& color) {
+    auto square = Shape::Square();
+    square.SetPosition(x, y);
+    square.SetScale(std::max(width, 1.F), height);
+    square.SetColor(color);
+    square.Draw(target, state);
+  };
+
+  auto row = [&](int index, int depth, const std::string& name,
+                 double cpu_duration, double gpu_duration) {
+    const float y = margin + row_height * float(index);
+    const float x = margin + label_width;
+    const float x_indent = x + indent * float(depth);
+    rectangle(x_indent, y + 2.F, float(cpu_duration / reference) * bar_width,
+              bar_height, Color::RGBA(0.3F, 0.8F, 0.3F, 1.F));  // NOLINT
+    if (gpu_duration >= 0.0) {
+      rectangle(x_indent, y + 2.F + bar_height,
+                float(gpu_duration / reference) * bar_width, bar_height,
+                Color::RGBA(0.9F, 0.5F, 0.2F, 1.F));  // NOLINT
+    }
+    if (font) {
+      std::string label = name + " " + FormatMilliseconds(cpu_duration);
+      if (gpu_duration >= 0.0) {
+        label += " / " + FormatMilliseconds(gpu_duration);
+      }
+      auto text = Text(*font, label);
+      text.SetPosition(margin + indent * float(depth), y);
+      text.Draw(target, state);
+    }
+  };
+
+  const int rows = 1 + int(frame.scopes.size());
+  rectangle(0.F, 0.F, 2.F * margin + label_width + bar_width * 1.2F,  // NOLINT
+            2.F * margin + row_height * float(rows),
+            Color::RGBA(0.F, 0.F, 0.F, 0.6F));  // NOLINT
+
+  // The 60 fps limit.
+  rectangle(margin + label_width + bar_width, 0.F, 1.F,
+            2.F * margin + row_height * float(rows), Color::Red);
+
+  row(0, 0, "Frame", frame.cpu_duration, frame.gpu_duration);
+  for (size_t i = 0; i < frame.scopes.size(); ++i) {
+    const ScopeResult& scope = frame.scopes[i];
+    row(int(i) + 1, scope.depth + 1, scope.name, scope.cpu_duration,
+        scope.gpu_duration);
+  }
+}
+
+}  // namespace smk
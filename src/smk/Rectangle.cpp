@@ -0,0 +1,35 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <smk/Rectangle.hpp>
+
+namespace smk {
+
+/// @brief The box bounding a rectangle once transformed. Only the 2D part of
+/// the transformation is used.
+/// @param box The rectangle.
+/// @param transformation The transformation applied to |box|.
+Rectangle TransformBoundingBox(const Rectangle& box,
+                               const glm::mat4& transformation) {
+  // Transform the center and the half-size of the box. The transformed box is
+  // bounded by |center| +/- |extent|.
+  const float center_x = (box.left + box.right) * 0.5F;  // NOLINT
+  const float center_y = (box.top + box.bottom) * 0.5F;  // NOLINT
+  const float half_x = (box.right - box.left) * 0.5F;    // NOLINT
+  const float half_y = (box.bottom - box.top) * 0.5F;    // NOLINT
+  const glm::vec2 axis_x = glm::vec2(transformation[0]);
+  const glm::vec2 axis_y = glm::vec2(transformation[1]);
+  const glm::vec2 center =
+      axis_x * center_x + axis_y * center_y + glm::vec2(transformation[3]);
+  const glm::vec2 extent =
+      glm::abs(axis_x) * half_x + glm::abs(axis_y) * half_y;
+  return {
+      center.x - extent.x,
+      center.y - extent.y,
+      center.x + extent.x,
+      center.y + extent.y,
+  };
+}
+
+}  // namespace smk
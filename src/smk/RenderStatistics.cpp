@@ -0,0 +1,42 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <smk/RenderStatistics.hpp>
+
+namespace smk {
+
+// Incremented where the work is submitted.
+RenderStatistics g_render_statistics;  // NOLINT
+
+/// @brief The counters difference in between two snapshots.
+RenderStatistics RenderStatistics::operator-(
+    const RenderStatistics& other) const {
+  RenderStatistics difference;
+  difference.draw_calls = draw_calls - other.draw_calls;
+  difference.vertices = vertices - other.vertices;
+  difference.triangles = triangles - other.triangles;
+  difference.state_changes = state_changes - other.state_changes;
+  difference.shader_switches = shader_switches - other.shader_switches;
+  difference.texture_binds = texture_binds - other.texture_binds;
+  difference.blend_changes = blend_changes - other.blend_changes;
+  difference.uniform_uploads = uniform_uploads - other.uniform_uploads;
+  difference.vertex_array_creations =
+      vertex_array_creations - other.vertex_array_creations;
+  difference.vertex_array_deletions =
+      vertex_array_deletions - other.vertex_array_deletions;
+  difference.buffer_creations = buffer_creations - other.buffer_creations;
+  difference.buffer_deletions = buffer_deletions - other.buffer_deletions;
+  difference.texture_creations = texture_creations - other.texture_creations;
+  difference.texture_deletions = texture_deletions - other.texture_deletions;
+  difference.bytes_uploaded = bytes_uploaded - other.bytes_uploaded;
+  return difference;
+}
+
+/// @brief The counters cumulated since the start of the program.
+// static
+const RenderStatistics& RenderStatistics::Total() {
+  return g_render_statistics;
+}
+
+}  // namespace smk
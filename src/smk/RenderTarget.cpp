@@ -2,29 +2,180 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <smk/Color.hpp>
+#include <smk/Context.hpp>
 #include <smk/Drawable.hpp>
+#include <smk/RenderStatistics.hpp>
 #include <smk/RenderTarget.hpp>
 #include <smk/Texture.hpp>
+#include <stdexcept>
 
 namespace smk {
-bool g_invalidate_textures = false;  // NOLINT
+bool g_invalidate_textures = false;       // NOLINT
+bool g_invalidate_vertex_arrays = false;  // NOLINT
+extern RenderStatistics g_render_statistics;  // NOLINT
 namespace {
 
 RenderTarget* render_target = nullptr;  // NOLINT
 RenderState cached_render_state_;       // NOLINT
 
+// The scissor test last applied. The box is in OpenGL coordinates.
+bool cached_scissor_test_ = false;             // NOLINT
+std::array<GLint, 4> cached_scissor_box_ = {};  // NOLINT
+
+// A ReadPixelsAsync request, waiting for the GPU to copy the pixels into
+// |pixel_buffer|.
+struct PendingReadPixels {
+  GLuint pixel_buffer = 0;
+  GLsync fence = nullptr;
+  int width = 0;
+  int height = 0;
+  std::promise<std::vector<uint8_t>> promise;
+};
+std::vector<PendingReadPixels> pending_read_pixels;  // NOLINT
+
+// OpenGL stores rows from bottom to top.
+void FlipRows(std::vector<uint8_t>& pixels, int width, int height) {
+  const int stride = 4 * width;
+  for (int y = 0; y < height / 2; ++y) {
+    std::swap_ranges(pixels.begin() + y * stride,
+                     pixels.begin() + (y + 1) * stride,
+                     pixels.begin() + (height - 1 - y) * stride);
+  }
+}
+
 const Texture& WhiteTexture() {
-  static const smk::Texture white_texture = [] {
+  static ContextResource<Texture> white_texture([] {
     static const uint8_t data[4] = {255, 255, 255, 255};  // NOLINT
     return smk::Texture(data, 1, 1);                      // NOLINT
-  }();
+  });
+
+  return white_texture.Get();
+}
+
+// A single triangle covering the whole clip space [-1,1]^2. The texture
+// coordinates cover [0,1]^2 on the visible area.
+const VertexArray& FullScreenTriangle() {
+  static ContextResource<VertexArray> full_screen_triangle([] {
+    return VertexArray({
+        {{-1.F, -1.F}, {0.F, 0.F}},
+        {{+3.F, -1.F}, {2.F, 0.F}},
+        {{-1.F, +3.F}, {0.F, 2.F}},
+    });
+  });
+  return full_screen_triangle.Get();
+}
 
-  return white_texture;
+// Whether the draw hides what is behind it. The alpha of the texture is
+// unknown, so only BlendMode::Replace guarantees it.
+bool IsOpaque(const RenderState& state) {
+  return state.blend_mode == BlendMode::Replace;
+}
+
+// Bind everything from |state|, except the view. Only what differs from the
+// previous call is updated.
+void ApplyRenderState(const RenderState& state) {
+  // Vertex Array
+  if (cached_render_state_.vertex_array != state.vertex_array ||
+      g_invalidate_vertex_arrays) {
+    cached_render_state_.vertex_array = state.vertex_array;
+    ++g_render_statistics.state_changes;
+    state.vertex_array.Bind();
+    g_invalidate_vertex_arrays = false;
+  }
+
+  // Shader
+  bool program_changed = false;
+  if (cached_render_state_.shader_program != state.shader_program) {
+    cached_render_state_.shader_program = state.shader_program;
+    ++g_render_statistics.state_changes;
+    ++g_render_statistics.shader_switches;
+    cached_render_state_.shader_program.Use();
+    program_changed = true;
+  }
+
+  // Color. Uniforms are stored per program, so the cached value is only valid
+  // for the program previously in use.
+  if (program_changed || cached_render_state_.color != state.color) {
+    cached_render_state_.color = state.color;
+    ++g_render_statistics.state_changes;
+    cached_render_state_.shader_program.SetUniform("color", state.color);
+  }
+
+  // Texture
+  const auto& texture = state.texture.id() ? state.texture : WhiteTexture();
+  if (cached_render_state_.texture != texture || g_invalidate_textures) {
+    cached_render_state_.texture = texture;
+    ++g_render_statistics.state_changes;
+    ++g_render_statistics.texture_binds;
+    texture.Bind();
+    g_invalidate_textures = false;
+  }
+
+  if (cached_render_state_.blend_mode != state.blend_mode) {
+    cached_render_state_.blend_mode = state.blend_mode;
+    ++g_render_statistics.state_changes;
+    ++g_render_statistics.blend_changes;
+    glEnable(GL_BLEND);
+    glBlendEquationSeparate(state.blend_mode.equation_rgb,
+                            state.blend_mode.equation_alpha);
+    glBlendFuncSeparate(state.blend_mode.src_rgb, state.blend_mode.dst_rgb,
+                        state.blend_mode.src_alpha, state.blend_mode.dst_alpha);
+  }
+
+  // Depth
+  if (cached_render_state_.depth_test != state.depth_test) {
+    cached_render_state_.depth_test = state.depth_test;
+    ++g_render_statistics.state_changes;
+    if (state.depth_test) {
+      glEnable(GL_DEPTH_TEST);
+    } else {
+      glDisable(GL_DEPTH_TEST);
+    }
+  }
+
+  if (cached_render_state_.depth_write != state.depth_write) {
+    cached_render_state_.depth_write = state.depth_write;
+    ++g_render_statistics.state_changes;
+    glDepthMask(state.depth_write ? GL_TRUE : GL_FALSE);
+  }
+
+  // Face culling
+  if (cached_render_state_.cull_face != state.cull_face) {
+    if (state.cull_face == GL_NONE) {
+      glDisable(GL_CULL_FACE);
+    } else {
+      if (cached_render_state_.cull_face == GL_NONE) {
+        glEnable(GL_CULL_FACE);
+      }
+      glCullFace(state.cull_face);
+    }
+    cached_render_state_.cull_face = state.cull_face;
+    ++g_render_statistics.state_changes;
+  }
 }
 
 }  // namespace
 
+void ResetRenderTargetCache() {
+  render_target = nullptr;
+  cached_render_state_ = RenderState();
+  cached_scissor_test_ = false;
+  cached_scissor_box_ = {};
+
+  // The pending reads can't complete anymore.
+  for (auto& pending : pending_read_pixels) {
+    glDeleteSync(pending.fence);
+    glDeleteBuffers(1, &pending.pixel_buffer);
+    pending.promise.set_exception(std::make_exception_ptr(
+        std::runtime_error("The OpenGL context was destroyed")));
+  }
+  pending_read_pixels.clear();
+}
+
 void RenderTarget::Bind(RenderTarget* target) {
   if (render_target == target) {
     return;
@@ -49,6 +200,13 @@ RenderTarget& RenderTarget::operator=(RenderTarget&& other) noexcept {
   std::swap(height_, other.height_);
   std::swap(projection_matrix_, other.projection_matrix_);
   std::swap(view_, other.view_);
+  std::swap(view_is_2d_, other.view_is_2d_);
+  std::swap(culling_, other.culling_);
+  std::swap(depth_test_, other.depth_test_);
+  std::swap(cull_face_, other.cull_face_);
+  std::swap(depth_sorting_, other.depth_sorting_);
+  std::swap(sorted_states_, other.sorted_states_);
+  std::swap(sorted_order_, other.sorted_order_);
   std::swap(vertex_shader_2d_, other.vertex_shader_2d_);
   std::swap(fragment_shader_2d_, other.fragment_shader_2d_);
   std::swap(shader_program_2d_, other.shader_program_2d_);
@@ -57,17 +215,34 @@ RenderTarget& RenderTarget::operator=(RenderTarget&& other) noexcept {
   std::swap(shader_program_3d_, other.shader_program_3d_);
   std::swap(shader_program_, other.shader_program_);
   std::swap(frame_buffer_, other.frame_buffer_);
+  std::swap(scissor_test_, other.scissor_test_);
+  std::swap(scissor_, other.scissor_);
+  std::swap(statistics_, other.statistics_);
+  std::swap(frame_begin_statistics_, other.frame_begin_statistics_);
   return *this;
 }
 
-/// @brief Clear the surface with a single color.
+/// @brief Clear the surface with a single color. The depth buffer is cleared
+/// too.
 /// @param color: An opaque color to fill the surface.
 void RenderTarget::Clear(const glm::vec4& color) {
   Bind(this);
+  ApplyScissor();
+
+  // The depth buffer is only cleared when it is writable.
+  if (!cached_render_state_.depth_write) {
+    cached_render_state_.depth_write = true;
+    glDepthMask(GL_TRUE);
+  }
+
   glClearColor(color.r, color.g, color.b, color.a);  // NOLINT
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+  // Reset the state possibly modified by direct OpenGL calls.
   glDisable(GL_DEPTH_TEST);
   glDisable(GL_CULL_FACE);
+  cached_render_state_.depth_test = false;
+  cached_render_state_.cull_face = GL_NONE;
 }
 
 /// @brief Set the View to use.
@@ -82,6 +257,7 @@ void RenderTarget::SetView(const View& view) {
                     0.F, z_y, 0.F, 0.F,    //
                     0.F, 0.F, 1.F, 0.F,    //
                     t_x, t_y, 0.F, 1.F));  //
+  view_is_2d_ = true;
 }
 
 /// @brief Set the View to use.
@@ -89,6 +265,7 @@ void RenderTarget::SetView(const View& view) {
 ///             screen space.
 void RenderTarget::SetView(const glm::mat4& mat) {
   projection_matrix_ = mat;
+  view_is_2d_ = false;
 }
 
 /// @brief Return the View currently assigned to this RenderTarget.
@@ -96,6 +273,182 @@ const View& RenderTarget::view() const {
   return view_;
 }
 
+/// @brief Enable or disable culling. When enabled, the objects entirely
+/// outside of the View are not drawn. This is enabled by default.
+///
+/// Culling is only effective when the View is set using a smk::View. It must
+/// be disabled when using a vertex shader moving vertices outside of the
+/// VertexArray::bounding_box().
+/// @param culling: Whether culling is enabled.
+void RenderTarget::SetCulling(bool culling) {
+  culling_ = culling;
+}
+
+/// @brief Check whether an object might be visible in the current View.
+/// @param bounding_box: The bounding box of the object, in its own coordinates.
+/// @param transformation: The transformation from the object's coordinates to
+///                        the View's coordinates.
+/// @return false when the object is entirely outside of the View, or of the
+///         scissor rectangle.
+bool RenderTarget::IsVisible(const Rectangle& bounding_box,
+                             const glm::mat4& transformation) const {
+  if (!culling_ || !view_is_2d_) {
+    return true;
+  }
+
+  const Rectangle box = TransformBoundingBox(bounding_box, transformation);
+  const Rectangle view = {
+      std::min(view_.Left(), view_.Right()),
+      std::min(view_.Top(), view_.Bottom()),
+      std::max(view_.Left(), view_.Right()),
+      std::max(view_.Top(), view_.Bottom()),
+  };
+  if (!box.Intersects(view)) {
+    return false;
+  }
+
+  return !scissor_test_ || ViewToPixels(box).Intersects(scissor_);
+}
+
+/// @brief The pixels an object might cover, origin at the top left corner.
+/// @param bounding_box: The bounding box of the object, in its own coordinates.
+/// @param transformation: The transformation from the object's coordinates to
+///                        the View's coordinates.
+/// @return The whole surface when the View isn't set using a smk::View.
+Rectangle RenderTarget::PixelBounds(const Rectangle& bounding_box,
+                                    const glm::mat4& transformation) const {
+  if (!view_is_2d_) {
+    return {0.F, 0.F, float(width_), float(height_)};
+  }
+  return ViewToPixels(TransformBoundingBox(bounding_box, transformation));
+}
+
+Rectangle RenderTarget::ViewToPixels(const Rectangle& rectangle) const {
+  const float scale_x = float(width_) / (view_.Right() - view_.Left());
+  const float scale_y = float(height_) / (view_.Bottom() - view_.Top());
+  const float x1 = (rectangle.left - view_.Left()) * scale_x;
+  const float x2 = (rectangle.right - view_.Left()) * scale_x;
+  const float y1 = (rectangle.top - view_.Top()) * scale_y;
+  const float y2 = (rectangle.bottom - view_.Top()) * scale_y;
+  return {
+      std::min(x1, x2),
+      std::min(y1, y2),
+      std::max(x1, x2),
+      std::max(y1, y2),
+  };
+}
+
+/// @brief Restrict the next drawings, including Clear(), to a rectangle. The
+/// objects entirely outside of it are skipped, like the ones outside of the
+/// View.
+/// @param rectangle: The area, in pixels. (0,0) is the top-left corner.
+void RenderTarget::SetScissor(const Rectangle& rectangle) {
+  scissor_test_ = true;
+  scissor_ = rectangle;
+}
+
+/// @brief Draw on the whole surface again. @see SetScissor.
+void RenderTarget::ResetScissor() {
+  scissor_test_ = false;
+}
+
+// Apply the scissor of this RenderTarget. Only what differs from the previous
+// call is updated.
+void RenderTarget::ApplyScissor() const {
+  if (cached_scissor_test_ != scissor_test_) {
+    cached_scissor_test_ = scissor_test_;
+    ++g_render_statistics.state_changes;
+    if (scissor_test_) {
+      glEnable(GL_SCISSOR_TEST);
+    } else {
+      glDisable(GL_SCISSOR_TEST);
+    }
+  }
+
+  if (!scissor_test_) {
+    return;
+  }
+
+  // OpenGL places the origin at the bottom left corner.
+  const GLint left = GLint(std::floor(scissor_.left));
+  const GLint right = GLint(std::ceil(scissor_.right));
+  const GLint top = GLint(std::floor(scissor_.top));
+  const GLint bottom = GLint(std::ceil(scissor_.bottom));
+  const std::array<GLint, 4> box = {
+      left,
+      height_ - bottom,
+      std::max(right - left, 0),
+      std::max(bottom - top, 0),
+  };
+  if (cached_scissor_box_ != box) {
+    cached_scissor_box_ = box;
+    ++g_render_statistics.state_changes;
+    glScissor(box[0], box[1], box[2], box[3]);
+  }
+}
+
+/// @brief Enable or disable the depth test of the next drawables. Fragments
+/// behind the ones already drawn are discarded. This is disabled by default.
+/// @param depth_test: Whether the depth test is enabled.
+void RenderTarget::SetDepthTest(bool depth_test) {
+  depth_test_ = depth_test;
+}
+
+/// @brief Set which faces of the next drawables are discarded. This is
+/// GL_NONE by default.
+/// @param cull_face: GL_BACK, GL_FRONT, GL_FRONT_AND_BACK or GL_NONE.
+void RenderTarget::SetCullFace(GLenum cull_face) {
+  cull_face_ = cull_face;
+}
+
+/// @brief Start queuing the draws, until RenderTarget::EndDepthSorting.
+///
+/// The opaque draws are submitted first, from front to back, so that the
+/// hidden fragments are rejected by the depth test before being shaded. The
+/// other ones are submitted after, from back to front, without writing the
+/// depth, so that they blend correctly. A draw is considered opaque when it
+/// uses BlendMode::Replace. Use it for solid 3D objects.
+///
+/// The depth of a draw is the one of the center of its 3D bounding box.
+/// Note: This is meant for 3D views. A 2D view draws everything at the same
+/// depth, in the order it was queued.
+void RenderTarget::BeginDepthSorting() {
+  depth_sorting_ = true;
+  sorted_states_.clear();
+}
+
+/// @brief Submit the draws queued since RenderTarget::BeginDepthSorting.
+void RenderTarget::EndDepthSorting() {
+  depth_sorting_ = false;
+
+  // Order the opaque draws first, with increasing depth. Then the transparent
+  // ones, with decreasing depth.
+  sorted_order_.clear();
+  for (size_t i = 0; i < sorted_states_.size(); ++i) {
+    RenderState& state = sorted_states_[i];
+    const glm::vec4 center = projection_matrix_ * state.view *
+                             glm::vec4(state.vertex_array.center(), 1.F);
+    // The normalized depth, in [-1, 1]. Behind the camera is considered far.
+    const float depth =
+        center.w > 0.F ? glm::clamp(center.z / center.w, -1.F, 1.F) : 1.F;
+    const bool opaque = IsOpaque(state);
+    if (!opaque) {
+      state.depth_write = false;
+    }
+    sorted_order_.emplace_back(opaque ? depth - 2.F : 2.F - depth, i);
+  }
+  std::stable_sort(sorted_order_.begin(), sorted_order_.end(),
+                   [](const std::pair<float, size_t>& a,
+                      const std::pair<float, size_t>& b) {
+                     return a.first < b.first;
+                   });
+
+  for (const auto& it : sorted_order_) {
+    Submit(sorted_states_[it.second]);
+  }
+  sorted_states_.clear();
+}
+
 /// @brief Set the ShaderProgram to be used.
 /// @param shader_program: The ShaderProgram to be used.
 ///
@@ -166,52 +519,62 @@ void RenderTarget::Draw(const Drawable& drawable) {
   state.view = glm::mat4(1.F);
   state.color = smk::Color::White;
   state.blend_mode = smk::BlendMode::Alpha;
+  state.depth_test = depth_test_;
+  state.cull_face = cull_face_;
   drawable.Draw(*this, state);
 }
 
 /// @brief Draw on the surface
 /// @param state: The RenderState to be usd for drawing.
 void RenderTarget::Draw(RenderState& state) {
-  // Vertex Array
-  if (cached_render_state_.vertex_array != state.vertex_array) {
-    cached_render_state_.vertex_array = state.vertex_array;
-    state.vertex_array.Bind();
+  if (!IsVisible(state.vertex_array.bounding_box(), state.view)) {
+    return;
   }
 
-  // Shader
-  if (cached_render_state_.shader_program != state.shader_program) {
-    cached_render_state_.shader_program = state.shader_program;
-    cached_render_state_.shader_program.Use();
+  if (depth_sorting_) {
+    sorted_states_.push_back(state);
+    return;
   }
 
-  // Color
-  if (cached_render_state_.color != state.color) {
-    cached_render_state_.color = state.color;
-    cached_render_state_.shader_program.SetUniform("color", state.color);
-  }
+  Submit(state);
+}
+
+void RenderTarget::Submit(RenderState& state) {
+  Bind(this);
+  ApplyScissor();
+  ApplyRenderState(state);
 
   // View (not cached)
   state.shader_program.SetUniform("projection", projection_matrix_);
   state.shader_program.SetUniform("view", state.view);
 
-  // Texture
-  const auto& texture = state.texture.id() ? state.texture : WhiteTexture();
-  if (cached_render_state_.texture != texture || g_invalidate_textures) {
-    cached_render_state_.texture = texture;
-    texture.Bind();
-    g_invalidate_textures = false;
-  }
-
-  if (cached_render_state_.blend_mode != state.blend_mode) {
-    cached_render_state_.blend_mode = state.blend_mode;
-    glEnable(GL_BLEND);
-    glBlendEquationSeparate(state.blend_mode.equation_rgb,
-                            state.blend_mode.equation_alpha);
-    glBlendFuncSeparate(state.blend_mode.src_rgb, state.blend_mode.dst_rgb,
-                        state.blend_mode.src_alpha, state.blend_mode.dst_alpha);
+  if (state.vertex_array.indexed()) {
+    glDrawElements(GL_TRIANGLES, GLsizei(state.vertex_array.size()),
+                   GL_UNSIGNED_INT, nullptr);
+  } else {
+    glDrawArrays(GL_TRIANGLES, 0, GLsizei(state.vertex_array.size()));
   }
+  ++g_render_statistics.draw_calls;
+  g_render_statistics.vertices += state.vertex_array.size();
+  g_render_statistics.triangles += state.vertex_array.size() / 3;
+}
 
+/// @brief Draw a single triangle covering the whole surface. This is meant for
+/// full-screen passes (post-processing, ...).
+///
+/// The vertex shader receives the clip space position in `space_position` and
+/// the texture coordinates in `texture_position`. The view, the projection and
+/// the vertex array are ignored.
+/// @param state: The RenderState to be used for drawing.
+void RenderTarget::DrawFullScreen(RenderState& state) {
+  Bind(this);
+  ApplyScissor();
+  state.vertex_array = FullScreenTriangle();
+  ApplyRenderState(state);
   glDrawArrays(GL_TRIANGLES, 0, GLsizei(state.vertex_array.size()));
+  ++g_render_statistics.draw_calls;
+  g_render_statistics.vertices += 3;
+  ++g_render_statistics.triangles;
 }
 
 /// @brief the dimension (width, height) of the drawing area.
@@ -232,6 +595,103 @@ int RenderTarget::height() const {
   return height_;
 }
 
+/// @brief The counters of the work submitted during the last frame.
+///
+/// Useful to catch regressions, like geometry rebuilt at every frame, or
+/// drawables not sharing their state.
+const RenderStatistics& RenderTarget::statistics() const {
+  return statistics_;
+}
+
+/// @brief The counters of the work submitted since the end of the last frame.
+RenderStatistics RenderTarget::current_statistics() const {
+  return RenderStatistics::Total() - frame_begin_statistics_;
+}
+
+/// @brief Mark the end of a frame. RenderTarget::statistics() then returns the
+/// counters of the frame. This is called by Window::Display().
+void RenderTarget::EndFrameStatistics() {
+  statistics_ = current_statistics();
+  frame_begin_statistics_ = RenderStatistics::Total();
+}
+
+/// @brief Read pixels from the surface. This waits for every previous drawing
+/// commands to complete. Prefer RenderTarget::ReadPixelsAsync outside of tests.
+///
+/// For a Window, this must be called before Window::Display().
+/// @param rectangle The area to read, in pixels. (0,0) is the top-left corner.
+/// @return The pixels, in RGBA with 8 bits per channel, from top to bottom.
+std::vector<uint8_t> RenderTarget::ReadPixels(const Rectangle& rectangle) {
+  Bind(this);
+  const int width = int(rectangle.width());
+  const int height = int(rectangle.height());
+  std::vector<uint8_t> pixels(4 * width * height);
+  glReadPixels(int(rectangle.left), height_ - int(rectangle.bottom), width,
+               height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+  FlipRows(pixels, width, height);
+  return pixels;
+}
+
+/// @brief Read pixels from the surface, without waiting for the GPU. The
+/// pixels are copied into a pixel buffer object. The future is fulfilled a
+/// frame or two later, by RenderTarget::PollReadPixels.
+///
+/// For a Window, this must be called before Window::Display(). Without a
+/// Window, e.g. with a HeadlessContext, RenderTarget::PollReadPixels must be
+/// called explicitly, otherwise the future is never fulfilled.
+/// @param rectangle The area to read, in pixels. (0,0) is the top-left corner.
+/// @return The pixels, in RGBA with 8 bits per channel, from top to bottom.
+std::future<std::vector<uint8_t>> RenderTarget::ReadPixelsAsync(
+    const Rectangle& rectangle) {
+  Bind(this);
+  PendingReadPixels pending;
+  pending.width = int(rectangle.width());
+  pending.height = int(rectangle.height());
+
+  glGenBuffers(1, &pending.pixel_buffer);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, pending.pixel_buffer);
+  glBufferData(GL_PIXEL_PACK_BUFFER, 4 * pending.width * pending.height,
+               nullptr, GL_STREAM_READ);
+  glReadPixels(int(rectangle.left), height_ - int(rectangle.bottom),
+               pending.width, pending.height, GL_RGBA, GL_UNSIGNED_BYTE,
+               nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  pending.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glFlush();
+
+  auto future = pending.promise.get_future();
+  pending_read_pixels.push_back(std::move(pending));
+  PollReadPixels();
+  return future;
+}
+
+// static
+/// @brief Fulfill the ReadPixelsAsync requests whose pixels have been copied by
+/// the GPU. This never blocks. It is called automatically by Window::Display().
+void RenderTarget::PollReadPixels() {
+  auto it = pending_read_pixels.begin();
+  while (it != pending_read_pixels.end()) {
+    GLenum status = glClientWaitSync(it->fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+      ++it;
+      continue;
+    }
+
+    std::vector<uint8_t> pixels(4 * it->width * it->height);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, it->pixel_buffer);
+    glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(pixels.size()),
+                       pixels.data());
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glDeleteSync(it->fence);
+    glDeleteBuffers(1, &it->pixel_buffer);
+
+    FlipRows(pixels, it->width, it->height);
+    it->promise.set_value(std::move(pixels));
+    it = pending_read_pixels.erase(it);
+  }
+}
+
 void RenderTarget::InitRenderTarget() {
   View default_view;
   default_view.SetCenter(float(width_) / 2.F, float(height_) / 2.F);  // NOLINT
@@ -0,0 +1,371 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <smk/RenderTarget.hpp>
+#include <smk/SceneGraph.hpp>
+#include <smk/VertexArray.hpp>
+
+namespace smk {
+
+namespace {
+
+// The affine transformation |parent| applied after |local|.
+glm::mat3x2 Compose(const glm::mat3x2& parent, const glm::mat3x2& local) {
+  glm::mat3x2 ret;
+  ret[0] = parent[0] * local[0].x + parent[1] * local[0].y;
+  ret[1] = parent[0] * local[1].x + parent[1] * local[1].y;
+  ret[2] = parent[0] * local[2].x + parent[1] * local[2].y + parent[2];
+  return ret;
+}
+
+// Equivalent to |view * mat4(affine)|.
+glm::mat4 Compose(const glm::mat4& view, const glm::mat3x2& affine) {
+  glm::mat4 ret = view;
+  ret[0] = view[0] * affine[0].x + view[1] * affine[0].y;
+  ret[1] = view[0] * affine[1].x + view[1] * affine[1].y;
+  ret[3] = view[0] * affine[2].x + view[1] * affine[2].y + view[3];
+  return ret;
+}
+
+// Returned by the accessors for dead handles.
+const std::vector<SceneGraph::Handle>& NoChildren() {
+  static const std::vector<SceneGraph::Handle> no_children;
+  return no_children;
+}
+
+const glm::mat3x2& Identity() {
+  static const glm::mat3x2 identity(1.F);
+  return identity;
+}
+
+}  // namespace
+
+/// @brief A SceneGraph with only its root node.
+SceneGraph::SceneGraph() {
+  nodes_.emplace_back();
+  nodes_[0].alive = true;
+}
+
+/// @brief Add an object as a child of the root node.
+/// @param object The object to be added. It is copied.
+/// @return The handle identifying the node in the scene.
+SceneGraph::Handle SceneGraph::Add(const Transformable& object) {
+  return Add(object, root());
+}
+
+/// @brief Add an object as the last child of |parent|.
+/// @param object The object to be added. It is copied. Its transformation is
+///               relative to |parent|.
+/// @param parent The parent node. The root node is used when it was removed.
+/// @return The handle identifying the node in the scene.
+SceneGraph::Handle SceneGraph::Add(const Transformable& object,
+                                   Handle parent) {
+  if (!IsAlive(parent)) {
+    parent = root();
+  }
+
+  Handle handle = 0;
+  if (free_handles_.empty()) {
+    handle = Handle(nodes_.size());
+    nodes_.emplace_back();
+  } else {
+    handle = free_handles_.back();
+    free_handles_.pop_back();
+  }
+
+  Node& node = nodes_[handle];
+  node.transformable = object;
+  node.parent = parent;
+  node.alive = true;
+  nodes_[parent].children.push_back(handle);
+  flattened_ = false;
+  return handle;
+}
+
+/// @brief Remove a node and its whole subtree from the scene. Their handles
+/// might be reused by future calls to SceneGraph::Add. The root node can't be
+/// removed. Removing a node twice does nothing.
+/// @param handle The node to be removed.
+void SceneGraph::Remove(Handle handle) {
+  if (handle == root() || !IsAlive(handle)) {
+    return;
+  }
+
+  auto& siblings = nodes_[nodes_[handle].parent].children;
+  siblings.erase(std::find(siblings.begin(), siblings.end(), handle));
+
+  std::vector<Handle> stack = {handle};
+  while (!stack.empty()) {
+    Handle current = stack.back();
+    stack.pop_back();
+    for (Handle child : nodes_[current].children) {
+      stack.push_back(child);
+    }
+    nodes_[current] = Node();
+    free_handles_.push_back(current);
+  }
+  flattened_ = false;
+}
+
+/// @brief Move a node and its subtree under a different parent. Its local
+/// transformation is kept, so it is now relative to the new parent. Nothing
+/// happens when |parent| belongs to the subtree of |handle|.
+/// @param handle The node to be moved.
+/// @param parent The new parent.
+void SceneGraph::SetParent(Handle handle, Handle parent) {
+  if (!IsAlive(handle) || !IsAlive(parent)) {
+    return;
+  }
+  for (Handle ancestor = parent; ancestor != root();
+       ancestor = nodes_[ancestor].parent) {
+    if (ancestor == handle) {
+      return;
+    }
+  }
+  if (handle == root()) {
+    return;
+  }
+
+  auto& siblings = nodes_[nodes_[handle].parent].children;
+  siblings.erase(std::find(siblings.begin(), siblings.end(), handle));
+  nodes_[handle].parent = parent;
+  nodes_[parent].children.push_back(handle);
+  flattened_ = false;
+}
+
+/// @brief The parent of a node. The root node is its own parent.
+SceneGraph::Handle SceneGraph::parent(Handle handle) const {
+  return IsAlive(handle) ? nodes_[handle].parent : root();
+}
+
+/// @brief The children of a node, in drawing order.
+const std::vector<SceneGraph::Handle>& SceneGraph::children(
+    Handle handle) const {
+  return IsAlive(handle) ? nodes_[handle].children : NoChildren();
+}
+
+/// @brief Access the object of a node.
+/// @param handle The node to be accessed.
+const Transformable& SceneGraph::Get(Handle handle) const {
+  // The root node is an empty Transformable.
+  return IsAlive(handle) ? nodes_[handle].transformable
+                         : nodes_[root()].transformable;
+}
+
+/// @brief Replace the object of a node. Its children are kept.
+/// @param handle The node to be modified.
+/// @param object The new object.
+void SceneGraph::Set(Handle handle, const Transformable& object) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  nodes_[handle].transformable = object;
+  Invalidate(handle);
+}
+
+/// @brief Set the position of a node, relative to its parent.
+/// @see Transformable::SetPosition.
+void SceneGraph::SetPosition(Handle handle, const glm::vec2& position) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  nodes_[handle].transformable.SetPosition(position);
+  Invalidate(handle);
+}
+
+/// @brief Move a node, relative to its parent.
+/// @see Transformable::Move.
+void SceneGraph::Move(Handle handle, const glm::vec2& move) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  nodes_[handle].transformable.Move(move);
+  Invalidate(handle);
+}
+
+/// @brief Set the rotation of a node, relative to its parent.
+/// @see Transformable::SetRotation.
+void SceneGraph::SetRotation(Handle handle, float rotation) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  nodes_[handle].transformable.SetRotation(rotation);
+  Invalidate(handle);
+}
+
+/// @brief Increase the rotation of a node.
+/// @see Transformable::Rotate.
+void SceneGraph::Rotate(Handle handle, float rotation) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  nodes_[handle].transformable.Rotate(rotation);
+  Invalidate(handle);
+}
+
+/// @brief Set the scale of a node, relative to its parent.
+/// @see Transformable::SetScale.
+void SceneGraph::SetScale(Handle handle, const glm::vec2& scale) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  nodes_[handle].transformable.SetScale(scale);
+  Invalidate(handle);
+}
+
+/// @brief Set the center of a node.
+/// @see Transformable::SetCenter.
+void SceneGraph::SetCenter(Handle handle, const glm::vec2& center) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  nodes_[handle].transformable.SetCenter(center);
+  Invalidate(handle);
+}
+
+/// @brief Show or hide a node and its subtree.
+void SceneGraph::SetVisible(Handle handle, bool visible) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  nodes_[handle].visible = visible;
+}
+
+/// @brief Whether the node is visible. Its parents might still be hidden.
+bool SceneGraph::visible(Handle handle) const {
+  return IsAlive(handle) && nodes_[handle].visible;
+}
+
+/// @brief The transformation of a node, relative to the scene. It combines the
+/// transformations of the node and of all its ancestors.
+const glm::mat3x2& SceneGraph::world(Handle handle) const {
+  if (!IsAlive(handle)) {
+    return Identity();
+  }
+  Update();
+  return world_[slot_[handle]];
+}
+
+/// @brief Convert a position relative to a node into the scene's coordinates.
+/// @param handle The node.
+/// @param local The position, relative to the node.
+glm::vec2 SceneGraph::ToWorld(Handle handle, const glm::vec2& local) const {
+  const glm::mat3x2& transformation = world(handle);
+  return transformation[0] * local.x + transformation[1] * local.y +
+         transformation[2];
+}
+
+/// @brief The number of nodes, including the root one.
+size_t SceneGraph::size() const {
+  return nodes_.size() - free_handles_.size();
+}
+
+bool SceneGraph::IsAlive(Handle handle) const {
+  return handle < nodes_.size() && nodes_[handle].alive;
+}
+
+void SceneGraph::Update() const {
+  if (!flattened_) {
+    Flatten();
+  }
+
+  if (!dirty_) {
+    return;
+  }
+
+  // Parents come before their children. A node is recomputed when it or one of
+  // its ancestors is dirty.
+  if (dirty_slot_[0]) {
+    local_[0] = nodes_[handle_[0]].transformable.affine();
+    world_[0] = local_[0];
+  }
+  const size_t size = handle_.size();
+  for (size_t slot = 1; slot < size; ++slot) {
+    const uint32_t parent_slot = parent_slot_[slot];
+    if (dirty_slot_[slot]) {
+      local_[slot] = nodes_[handle_[slot]].transformable.affine();
+    } else if (dirty_slot_[parent_slot]) {
+      dirty_slot_[slot] = 1;
+    } else {
+      continue;
+    }
+    world_[slot] = Compose(world_[parent_slot], local_[slot]);
+  }
+
+  std::fill(dirty_slot_.begin(), dirty_slot_.end(), 0);
+  dirty_ = false;
+}
+
+/// @brief Draw the visible nodes, in depth-first order.
+void SceneGraph::Draw(RenderTarget& target, RenderState state) const {
+  Update();
+
+  const size_t size = handle_.size();
+  size_t slot = 0;
+  while (slot < size) {
+    const Node& node = nodes_[handle_[slot]];
+    if (!node.visible) {
+      slot += subtree_size_[slot];
+      continue;
+    }
+
+    const Transformable& object = node.transformable;
+    if (object.vertex_array().size() != 0) {
+      RenderState node_state = state;
+      node_state.view = Compose(state.view, world_[slot]);
+      node_state.color *= object.color();
+      node_state.texture = object.texture();
+      node_state.vertex_array = object.vertex_array();
+      node_state.blend_mode = object.blend_mode();
+      target.Draw(node_state);
+    }
+    ++slot;
+  }
+}
+
+// Mark the subtree of |handle| for recomputation.
+void SceneGraph::Invalidate(Handle handle) {
+  if (!flattened_) {
+    return;  // Everything will be recomputed anyway.
+  }
+  dirty_slot_[slot_[handle]] = 1;
+  dirty_ = true;
+}
+
+// Rebuild the depth-first ordered arrays from the hierarchy.
+void SceneGraph::Flatten() const {
+  handle_.clear();
+  parent_slot_.clear();
+  slot_.assign(nodes_.size(), 0);
+
+  std::vector<Handle> stack = {root()};
+  while (!stack.empty()) {
+    const Handle handle = stack.back();
+    stack.pop_back();
+
+    const auto slot = uint32_t(handle_.size());
+    slot_[handle] = slot;
+    handle_.push_back(handle);
+    parent_slot_.push_back(slot_[nodes_[handle].parent]);
+
+    // Push in reverse, so that the first child is visited first.
+    const auto& children = nodes_[handle].children;
+    stack.insert(stack.end(), children.rbegin(), children.rend());
+  }
+
+  const size_t size = handle_.size();
+  subtree_size_.assign(size, 1);
+  for (size_t slot = size - 1; slot >= 1; --slot) {
+    subtree_size_[parent_slot_[slot]] += subtree_size_[slot];
+  }
+
+  local_.resize(size);
+  world_.resize(size);
+  dirty_slot_.assign(size, 1);
+  flattened_ = true;
+  dirty_ = true;
+}
+
+}  // namespace smk
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
+#include <smk/RenderStatistics.hpp>
 #include <smk/Shader.hpp>
 #include <stdexcept>
 #include <streambuf>
@@ -15,6 +16,7 @@
 namespace smk {
 
 extern bool g_khr_parallel_shader; // NOLINT
+extern RenderStatistics g_render_statistics;  // NOLINT
 
 using namespace glm;
 
@@ -379,6 +381,15 @@ void ShaderProgram::SetUniform(const std::string& name,
                                float y,
                                float z) {
   glUniform3f(Uniform(name), x, y, z);
+  ++g_render_statistics.uniform_uploads;
+}
+
+/// @brief Assign shader vec2 uniform
+/// @param v vec2 value
+/// @overload
+void ShaderProgram::SetUniform(const std::string& name, const vec2& v) {
+  glUniform2fv(Uniform(name), 1, value_ptr(v));
+  ++g_render_statistics.uniform_uploads;
 }
 
 /// @brief Assign shader vec3 uniform
@@ -386,6 +397,7 @@ void ShaderProgram::SetUniform(const std::string& name,
 /// @overload
 void ShaderProgram::SetUniform(const std::string& name, const vec3& v) {
   glUniform3fv(Uniform(name), 1, value_ptr(v));
+  ++g_render_statistics.uniform_uploads;
 }
 
 /// @brief Assign shader vec4 uniform
@@ -393,6 +405,7 @@ void ShaderProgram::SetUniform(const std::string& name, const vec3& v) {
 /// @overload
 void ShaderProgram::SetUniform(const std::string& name, const vec4& v) {
   glUniform4fv(Uniform(name), 1, value_ptr(v));
+  ++g_render_statistics.uniform_uploads;
 }
 
 /// @brief Assign shader mat4 uniform
@@ -400,6 +413,7 @@ void ShaderProgram::SetUniform(const std::string& name, const vec4& v) {
 /// @overload
 void ShaderProgram::SetUniform(const std::string& name, const mat4& m) {
   glUniformMatrix4fv(Uniform(name), 1, GL_FALSE, value_ptr(m));
+  ++g_render_statistics.uniform_uploads;
 }
 
 /// @brief Assign shader mat3 uniform
@@ -407,6 +421,7 @@ void ShaderProgram::SetUniform(const std::string& name, const mat4& m) {
 /// @overload
 void ShaderProgram::SetUniform(const std::string& name, const mat3& m) {
   glUniformMatrix3fv(Uniform(name), 1, GL_FALSE, value_ptr(m));
+  ++g_render_statistics.uniform_uploads;
 }
 
 /// @brief Assign shader float uniform
@@ -414,6 +429,7 @@ void ShaderProgram::SetUniform(const std::string& name, const mat3& m) {
 /// @overload
 void ShaderProgram::SetUniform(const std::string& name, float val) {
   glUniform1f(Uniform(name), val);
+  ++g_render_statistics.uniform_uploads;
 }
 
 /// @brief Assign shader int uniform
@@ -421,6 +437,7 @@ void ShaderProgram::SetUniform(const std::string& name, float val) {
 /// @overload
 void ShaderProgram::SetUniform(const std::string& name, int val) {
   glUniform1i(Uniform(name), val);
+  ++g_render_statistics.uniform_uploads;
 }
 
 
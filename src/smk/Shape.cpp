@@ -4,7 +4,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <smk/Bezier.hpp>
+#include <smk/GeometryCache.hpp>
 #include <smk/Shape.hpp>
+#include <unordered_map>
 
 #ifndef M_PI
   #define M_PI 3.14159265358979323846
@@ -12,60 +16,27 @@
 
 namespace smk {
 
-Transformable Shape::FromVertexArray(VertexArray vertex_array) {
-  Transformable drawable;
-  drawable.SetVertexArray(std::move(vertex_array));
-  return drawable;
-}
+namespace {
 
-/// @brief Return a line with a given thickness
-/// @param a The first end.
-/// @param b Second end.
-/// @param thickness This line thickness.
-Transformable Shape::Line(const glm::vec2& a,
-                          const glm::vec2& b,
-                          float thickness) {
+using Generator = GeometryCache::Generator;
+
+VertexArray BuildLine(const glm::vec2& a,
+                      const glm::vec2& b,
+                      float thickness) {
   glm::vec2 dt = glm::normalize(glm::vec2(b.y - a.y, -b.x + a.x)) * thickness *
                  0.5F;  // NOLINT
 
-  return FromVertexArray(VertexArray({
+  return VertexArray({
       {a + dt, {0.F, 0.F}},
       {b + dt, {1.F, 0.F}},
       {b - dt, {1.F, 1.F}},
       {a + dt, {0.F, 0.F}},
       {b - dt, {1.F, 1.F}},
       {a - dt, {0.F, 1.F}},
-  }));
-}
-
-/// @brief Return the square [0,1]x[0,1]
-Transformable Shape::Square() {
-  static VertexArray vertex_array;
-
-  if (!vertex_array.size()) {
-    vertex_array = VertexArray({
-        {{0.F, 0.F}, {0.F, 0.F}},
-        {{1.F, 0.F}, {1.F, 0.F}},
-        {{1.F, 1.F}, {1.F, 1.F}},
-        {{0.F, 0.F}, {0.F, 0.F}},
-        {{1.F, 1.F}, {1.F, 1.F}},
-        {{0.F, 1.F}, {0.F, 1.F}},
-    });
-  }
-
-  return FromVertexArray(vertex_array);
-}
-
-/// @brief Return a circle.
-/// @param radius The circle'radius.
-Transformable Shape::Circle(float radius) {
-  return Circle(radius, 16 + radius * 0.9); // NOLINT
+  });
 }
 
-/// @brief Return a circle.
-/// @param radius The circle'radius.
-/// @param subdivisions The number of triangles used for drawing the circle.
-Transformable Shape::Circle(float radius, int subdivisions) {
+VertexArray BuildCircle(float radius, int subdivisions) {
   std::vector<Vertex> v;
   glm::vec2 p1 = glm::vec2(1.0f, 0.0f);
   glm::vec2 t1 = glm::vec2(0.5F, 0.5F) + 0.5F * p1; // NOLINT
@@ -82,128 +53,466 @@ Transformable Shape::Circle(float radius, int subdivisions) {
     t1 = t2;
   }
 
-  return FromVertexArray(VertexArray(v));
+  return VertexArray(v);
 }
 
-/// @brief Return a centered 1x1x1 3D cube
-Transformable3D Shape::Cube() {
+VertexArray BuildPath(const std::vector<glm::vec2>& points,
+                      const Stroker::Style& style) {
+  // The buffers of the stroker are reused from one path to the next.
+  static Stroker stroker;
+  stroker.Clear();
+  stroker.SetStyle(style);
+  stroker.Add(points);
+  return stroker.vertex_array();
+}
+
+VertexArray BuildRoundedRectangle(float width,
+                                  float height,
+                                  float radius,
+                                  int corner_subdivisions) {
+  radius = std::max(radius, 0.F);
+  radius = std::min(radius, width * 0.5F); // NOLINT
+  radius = std::min(radius, height * 0.5F); // NOLINT
+  corner_subdivisions = std::max(corner_subdivisions, 1);
+
+  width = width * 0.5F - radius; // NOLINT
+  height = height * 0.5F - radius; // NOLINT
+  const glm::vec2 centers[4] = {
+      {+width, +height},
+      {-width, +height},
+      {-width, -height},
+      {+width, -height},
+  };
+
+  // The outline, one quarter of circle per corner.
+  std::vector<glm::vec2> outline;
+  const float angle_delta = float(0.5 * M_PI) / float(corner_subdivisions);
+  for (int corner = 0; corner < 4; ++corner) {
+    for (int i = 0; i <= corner_subdivisions; ++i) {
+      const float angle = float(0.5 * M_PI * corner) + angle_delta * float(i);
+      outline.push_back(centers[corner] +
+                        radius * glm::vec2(std::cos(angle), std::sin(angle)));
+    }
+  }
+
+  // Fill it with a fan of triangles around the center.
+  std::vector<smk::Vertex> v;
+  const smk::Vertex p0 = {{0.F, 0.F}, {0.F, 0.F}};
+  for (size_t i = 0; i < outline.size(); ++i) {
+    v.push_back(p0);
+    v.push_back({outline[i], {0.F, 0.F}});
+    v.push_back({outline[(i + 1) % outline.size()], {0.F, 0.F}});
+  }
+
+  return VertexArray(v);
+}
+
+// Every face of the cube, as its normal and two axes. The corners are listed
+// counter-clockwise when seen from the outside.
+VertexArray BuildCube() {
+  struct Face {
+    glm::vec3 normal;
+    glm::vec3 u;
+    glm::vec3 v;
+  };
+  const Face faces[6] = {
+      {{+0.F, +0.F, +1.F}, {+1.F, +0.F, +0.F}, {+0.F, +1.F, +0.F}},
+      {{+0.F, +0.F, -1.F}, {-1.F, +0.F, +0.F}, {+0.F, +1.F, +0.F}},
+      {{+0.F, +1.F, +0.F}, {+0.F, +0.F, +1.F}, {+1.F, +0.F, +0.F}},
+      {{+0.F, -1.F, +0.F}, {+1.F, +0.F, +0.F}, {+0.F, +0.F, +1.F}},
+      {{+1.F, +0.F, +0.F}, {+0.F, +1.F, +0.F}, {+0.F, +0.F, +1.F}},
+      {{-1.F, +0.F, +0.F}, {+0.F, +0.F, +1.F}, {+0.F, +1.F, +0.F}},
+  };
+  const glm::vec2 corners[4] = {{0.F, 0.F}, {1.F, 0.F}, {1.F, 1.F}, {0.F, 1.F}};
+
+  std::vector<Vertex3D> vertices;
+  std::vector<GLuint> indices;
+  for (const Face& face : faces) {
+    const auto base = GLuint(vertices.size());
+    for (const glm::vec2& corner : corners) {
+      const glm::vec2 offset = corner - 0.5F;  // NOLINT
+      vertices.push_back({
+          0.5F * face.normal + offset.x * face.u + offset.y * face.v,  // NOLINT
+          face.normal,
+          corner,
+      });
+    }
+    indices.insert(indices.end(), {base + 0, base + 1, base + 2,  //
+                                   base + 0, base + 2, base + 3});
+  }
+  return VertexArray(vertices, indices);
+}
+
+VertexArray BuildPlane() {
   constexpr float m = -0.5F;
   constexpr float z = +0.F;
   constexpr float p = +0.5F;
   constexpr float l = 0.F;
   constexpr float r = 1.F;
-  auto vertex_array = smk::VertexArray({
-      {{m, m, p}, {z, z, p}, {l, l}}, {{p, m, p}, {z, z, p}, {r, l}},
-      {{p, p, p}, {z, z, p}, {r, r}}, {{m, m, p}, {z, z, p}, {l, l}},
-      {{p, p, p}, {z, z, p}, {r, r}}, {{m, p, p}, {z, z, p}, {l, r}},
-
-      {{m, m, m}, {z, z, m}, {l, l}}, {{p, p, m}, {z, z, m}, {r, r}},
-      {{p, m, m}, {z, z, m}, {r, l}}, {{m, m, m}, {z, z, m}, {l, l}},
-      {{m, p, m}, {z, z, m}, {l, r}}, {{p, p, m}, {z, z, m}, {r, r}},
-
-      {{m, p, m}, {z, p, z}, {l, l}}, {{m, p, p}, {z, p, z}, {r, l}},
-      {{p, p, p}, {z, p, z}, {r, r}}, {{m, p, m}, {z, p, z}, {l, l}},
-      {{p, p, p}, {z, p, z}, {r, r}}, {{p, p, m}, {z, p, z}, {l, r}},
-
-      {{m, m, m}, {z, m, z}, {l, l}}, {{p, m, p}, {z, m, z}, {r, r}},
-      {{m, m, p}, {z, m, z}, {r, l}}, {{m, m, m}, {z, m, z}, {l, l}},
-      {{p, m, m}, {z, m, z}, {l, r}}, {{p, m, p}, {z, m, z}, {r, r}},
-
-      {{p, m, m}, {p, z, z}, {l, l}}, {{p, p, m}, {p, z, z}, {r, l}},
-      {{p, p, p}, {p, z, z}, {r, r}}, {{p, m, m}, {p, z, z}, {l, l}},
-      {{p, p, p}, {p, z, z}, {r, r}}, {{p, m, p}, {p, z, z}, {l, r}},
-
-      {{m, m, m}, {m, z, z}, {l, l}}, {{m, p, p}, {m, z, z}, {r, r}},
-      {{m, p, m}, {m, z, z}, {r, l}}, {{m, m, m}, {m, z, z}, {l, l}},
-      {{m, m, p}, {m, z, z}, {l, r}}, {{m, p, p}, {m, z, z}, {r, r}},
-  });
+  const std::vector<Vertex3D> vertices = {
+      {{m, m, z}, {z, z, r}, {l, l}},
+      {{p, m, z}, {z, z, r}, {r, l}},
+      {{p, p, z}, {z, z, r}, {r, r}},
+      {{m, p, z}, {z, z, r}, {l, r}},
+  };
+  return VertexArray(vertices, {0, 1, 2, 0, 2, 3});
+}
 
-  Transformable3D transformable;
-  transformable.SetVertexArray(std::move(vertex_array));
-  return transformable;
+// The original IcoSphere subdivided an octahedron, producing 8 x 3^iteration
+// triangles. Return the number of subdivisions of the icosahedron producing the
+// closest number of triangles, 20 x 4^level, so that callers keep the same
+// cost.
+int IcoSphereSubdivisions(int iteration) {
+  const double triangles = 8.0 * std::pow(3.0, iteration);  // NOLINT
+  int level = 0;
+  while (20.0 * std::pow(4.0, level + 1) <= triangles) {  // NOLINT
+    ++level;
+  }
+  const double below = 20.0 * std::pow(4.0, level);      // NOLINT
+  const double above = 20.0 * std::pow(4.0, level + 1);  // NOLINT
+  return (above - triangles < triangles - below) ? level + 1 : level;
 }
 
-/// @brief A centered sphere
-/// @param iteration
-///   Control the number of triangle used to make the sphere. It will contain
-///   \f$ 8 \time 3^iteration\f$ triangles.
-Transformable3D Shape::IcoSphere(int iteration) {
-  std::vector<glm::vec3> out = {
-      {+1.F, +0.F, +0.F}, {+0.F, +1.F, +0.F}, {+0.F, +0.F, +1.F},
-      {-1.F, +0.F, +0.F}, {+0.F, +0.F, -1.F}, {+0.F, -1.F, +0.F},
-      {+0.F, -1.F, +0.F}, {+1.F, +0.F, +0.F}, {+0.F, +0.F, +1.F},
-      {+0.F, +1.F, +0.F}, {+0.F, +0.F, -1.F}, {-1.F, +0.F, +0.F},
-      {-1.F, +0.F, +0.F}, {+0.F, -1.F, +0.F}, {+0.F, +0.F, +1.F},
-      {+1.F, +0.F, +0.F}, {+0.F, +0.F, -1.F}, {+0.F, +1.F, +0.F},
-      {+0.F, +1.F, +0.F}, {-1.F, +0.F, +0.F}, {+0.F, +0.F, +1.F},
-      {+0.F, -1.F, +0.F}, {+0.F, +0.F, -1.F}, {+1.F, +0.F, +0.F},
+// Subdivide an icosahedron. Every edge is split in its middle, shared in
+// between the two faces using it.
+VertexArray BuildIcoSphere(int iteration) {
+  const float t = float(1.0 + std::sqrt(5.0)) * 0.5F;  // NOLINT
+  std::vector<glm::vec3> positions = {
+      {-1.F, +t, +0.F}, {+1.F, +t, +0.F}, {-1.F, -t, +0.F}, {+1.F, -t, +0.F},
+      {+0.F, -1.F, +t}, {+0.F, +1.F, +t}, {+0.F, -1.F, -t}, {+0.F, +1.F, -t},
+      {+t, +0.F, -1.F}, {+t, +0.F, +1.F}, {-t, +0.F, -1.F}, {-t, +0.F, +1.F},
+  };
+  for (auto& position : positions) {
+    position = glm::normalize(position);
+  }
+
+  std::vector<GLuint> indices = {
+      0, 11, 5,  0, 5,  1, 0, 1, 7, 0, 7,  10, 0, 10, 11,  //
+      1, 5,  9,  5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1,  8,  //
+      3, 9,  4,  3, 4,  2, 3, 2, 6, 3, 6,  8,  3, 8,  9,   //
+      4, 9,  5,  2, 4,  11, 6, 2, 10, 8, 6, 7, 9, 8,  1,   //
+  };
+
+  std::unordered_map<uint64_t, GLuint> middles;
+  auto middle = [&](GLuint a, GLuint b) {
+    const uint64_t key = (uint64_t(std::min(a, b)) << 32U) | std::max(a, b);
+    auto it = middles.find(key);
+    if (it != middles.end()) {
+      return it->second;
+    }
+    const auto index = GLuint(positions.size());
+    positions.push_back(glm::normalize(positions[a] + positions[b]));
+    middles[key] = index;
+    return index;
   };
 
   for (int i = 0; i < iteration; ++i) {
-    std::vector<glm::vec3> in;
-    std::swap(in, out);
-    for (unsigned int j = 0; j < in.size();) {
-      glm::vec3& a = in[j++];
-      glm::vec3& b = in[j++];
-      glm::vec3& c = in[j++];
-      glm::vec3 d = glm::normalize(a + b + c);
-      auto addition = {a, b, d, b, c, d, c, a, d};
-      out.insert(out.end(), addition.begin(), addition.end());  // NOLINT
+    std::vector<GLuint> subdivided;
+    subdivided.reserve(4 * indices.size());
+    middles.clear();
+    for (size_t j = 0; j < indices.size(); j += 3) {
+      const GLuint a = indices[j + 0];
+      const GLuint b = indices[j + 1];
+      const GLuint c = indices[j + 2];
+      const GLuint ab = middle(a, b);
+      const GLuint bc = middle(b, c);
+      const GLuint ca = middle(c, a);
+      subdivided.insert(subdivided.end(), {a, ab, ca, ab, b, bc,  //
+                                           ca, bc, c, ab, bc, ca});
     }
+    indices = std::move(subdivided);
   }
 
-  std::vector<Vertex3D> vertex_array(out.size());
-  for (auto& it : out) {
-    vertex_array.push_back(
+  std::vector<Vertex3D> vertices;
+  vertices.reserve(positions.size());
+  for (const auto& it : positions) {
+    vertices.push_back(
         {it * 0.5F, it, {it.x * 0.5F + 0.5F, it.y * 0.5F + 0.5F}});  // NOLINT
   }
+  return VertexArray(vertices, indices);
+}
 
-  Transformable3D transformable;
-  transformable.SetVertexArray(vertex_array);
-  return transformable;
+// Add the triangles of a grid of (columns + 1) x (rows + 1) vertices,
+// starting at |base|.
+void AddGridIndices(GLuint base,
+                    int columns,
+                    int rows,
+                    std::vector<GLuint>* indices) {
+  const auto stride = GLuint(columns + 1);
+  for (int row = 0; row < rows; ++row) {
+    for (int column = 0; column < columns; ++column) {
+      const GLuint a = base + GLuint(row) * stride + GLuint(column);
+      const GLuint b = a + 1;
+      const GLuint c = a + stride + 1;
+      const GLuint d = a + stride;
+      indices->insert(indices->end(), {a, b, c, a, c, d});
+    }
+  }
 }
 
-/// @brief Return a centered 1x1 square in a 3D space.
-Transformable3D Shape::Plane() {
-  constexpr float m = -0.5F;
-  constexpr float z = +0.F;
-  constexpr float p = +0.5F;
-  constexpr float l = 0.F;
-  constexpr float r = 1.F;
-  auto vertex_array = smk::VertexArray({
-      {{m, m, z}, {z, z, p}, {l, l}},
-      {{p, m, z}, {z, z, p}, {r, l}},
-      {{p, p, z}, {z, z, p}, {r, r}},
-      {{m, m, z}, {z, z, p}, {l, l}},
-      {{p, p, z}, {z, z, p}, {r, r}},
-      {{m, p, z}, {z, z, p}, {l, r}},
-  });
+VertexArray BuildUVSphere(int slices, int stacks) {
+  std::vector<Vertex3D> vertices;
+  std::vector<GLuint> indices;
+  vertices.reserve(size_t(slices + 1) * size_t(stacks + 1));
+  for (int stack = 0; stack <= stacks; ++stack) {
+    const float v = float(stack) / float(stacks);
+    const float theta = float(M_PI) * v;
+    for (int slice = 0; slice <= slices; ++slice) {
+      const float u = float(slice) / float(slices);
+      const float phi = float(2.0 * M_PI) * u;
+      const glm::vec3 normal = {
+          std::sin(theta) * std::sin(phi),
+          -std::cos(theta),
+          std::sin(theta) * std::cos(phi),
+      };
+      vertices.push_back({normal * 0.5F, normal, {u, v}});  // NOLINT
+    }
+  }
+
+  // Skip the degenerate triangles touching the poles.
+  const auto stride = GLuint(slices + 1);
+  for (int stack = 0; stack < stacks; ++stack) {
+    for (int slice = 0; slice < slices; ++slice) {
+      const GLuint a = GLuint(stack) * stride + GLuint(slice);
+      const GLuint b = a + 1;
+      const GLuint c = a + stride + 1;
+      const GLuint d = a + stride;
+      if (stack != 0) {
+        indices.insert(indices.end(), {a, b, c});
+      }
+      if (stack != stacks - 1) {
+        indices.insert(indices.end(), {a, c, d});
+      }
+    }
+  }
+  return VertexArray(vertices, indices);
+}
 
+VertexArray BuildCylinder(int subdivisions) {
+  std::vector<Vertex3D> vertices;
+  std::vector<GLuint> indices;
+
+  // The side.
+  for (int i = 0; i <= subdivisions; ++i) {
+    const float u = float(i) / float(subdivisions);
+    const float phi = float(2.0 * M_PI) * u;
+    const glm::vec3 normal = {std::sin(phi), 0.F, std::cos(phi)};
+    vertices.push_back({normal * 0.5F + glm::vec3(0.F, -0.5F, 0.F),  // NOLINT
+                        normal,
+                        {u, 0.F}});
+  }
+  for (int i = 0; i <= subdivisions; ++i) {
+    const float u = float(i) / float(subdivisions);
+    const float phi = float(2.0 * M_PI) * u;
+    const glm::vec3 normal = {std::sin(phi), 0.F, std::cos(phi)};
+    vertices.push_back({normal * 0.5F + glm::vec3(0.F, +0.5F, 0.F),  // NOLINT
+                        normal,
+                        {u, 1.F}});
+  }
+  AddGridIndices(0, subdivisions, 1, &indices);
+
+  // The two caps, as fans of triangles.
+  for (float side : {-1.F, +1.F}) {
+    const auto center = GLuint(vertices.size());
+    const glm::vec3 normal = {0.F, side, 0.F};
+    vertices.push_back({normal * 0.5F, normal, {0.5F, 0.5F}});  // NOLINT
+    for (int i = 0; i < subdivisions; ++i) {
+      const float phi = float(2.0 * M_PI) * float(i) / float(subdivisions);
+      const glm::vec2 rim = {std::sin(phi), std::cos(phi)};
+      vertices.push_back({
+          glm::vec3(rim.x, side, rim.y) * 0.5F,  // NOLINT
+          normal,
+          rim * 0.5F + 0.5F,                     // NOLINT
+      });
+    }
+    for (int i = 0; i < subdivisions; ++i) {
+      const GLuint a = center + 1 + GLuint(i);
+      const GLuint b = center + 1 + GLuint((i + 1) % subdivisions);
+      if (side > 0.F) {
+        indices.insert(indices.end(), {center, a, b});
+      } else {
+        indices.insert(indices.end(), {center, b, a});
+      }
+    }
+  }
+  return VertexArray(vertices, indices);
+}
+
+VertexArray BuildTorus(float tube_radius,
+                       int major_subdivisions,
+                       int minor_subdivisions) {
+  const float major_radius = 0.5F - tube_radius;  // NOLINT
+  std::vector<Vertex3D> vertices;
+  std::vector<GLuint> indices;
+  vertices.reserve(size_t(major_subdivisions + 1) *
+                   size_t(minor_subdivisions + 1));
+  for (int i = 0; i <= minor_subdivisions; ++i) {
+    const float v = float(i) / float(minor_subdivisions);
+    const float theta = float(2.0 * M_PI) * v;
+    for (int j = 0; j <= major_subdivisions; ++j) {
+      const float u = float(j) / float(major_subdivisions);
+      const float phi = float(2.0 * M_PI) * u;
+      const glm::vec3 direction = {std::sin(phi), 0.F, std::cos(phi)};
+      const glm::vec3 normal = direction * std::cos(theta) +
+                               glm::vec3(0.F, std::sin(theta), 0.F);
+      vertices.push_back({
+          direction * major_radius + normal * tube_radius,
+          normal,
+          {u, v},
+      });
+    }
+  }
+  AddGridIndices(0, major_subdivisions, minor_subdivisions, &indices);
+  return VertexArray(vertices, indices);
+}
+
+Transformable3D FromVertexArray3D(VertexArray vertex_array) {
   Transformable3D transformable;
   transformable.SetVertexArray(std::move(vertex_array));
   return transformable;
 }
 
+}  // namespace
+
+Transformable Shape::FromVertexArray(VertexArray vertex_array) {
+  Transformable drawable;
+  drawable.SetVertexArray(std::move(vertex_array));
+  return drawable;
+}
+
+/// @brief Return a line with a given thickness
+/// @param a The first end.
+/// @param b Second end.
+/// @param thickness This line thickness.
+Transformable Shape::Line(const glm::vec2& a,
+                          const glm::vec2& b,
+                          float thickness) {
+  // Not cached: the key would be the coordinates, which rarely repeat.
+  return FromVertexArray(BuildLine(a, b, thickness));
+}
+
+/// @brief Return the square [0,1]x[0,1]
+Transformable Shape::Square() {
+  return FromVertexArray(GeometryCache::Default().Get(
+      {float(Generator::Square)}, [] {
+        return VertexArray({
+            {{0.F, 0.F}, {0.F, 0.F}},
+            {{1.F, 0.F}, {1.F, 0.F}},
+            {{1.F, 1.F}, {1.F, 1.F}},
+            {{0.F, 0.F}, {0.F, 0.F}},
+            {{1.F, 1.F}, {1.F, 1.F}},
+            {{0.F, 1.F}, {0.F, 1.F}},
+        });
+      }));
+}
+
+/// @brief Return a circle.
+/// @param radius The circle'radius.
+Transformable Shape::Circle(float radius) {
+  return Circle(radius, 16 + radius * 0.9); // NOLINT
+}
+
+/// @brief Return a circle.
+/// @param radius The circle'radius.
+/// @param subdivisions The number of triangles used for drawing the circle.
+Transformable Shape::Circle(float radius, int subdivisions) {
+  const GeometryCache::Key key = {
+      float(Generator::Circle), radius, float(subdivisions),
+  };
+  return FromVertexArray(GeometryCache::Default().Get(
+      key, [&] { return BuildCircle(radius, subdivisions); }));
+}
+
+/// @brief Return a circle, tessellated according to its size on screen.
+/// @see Shape::CircleSubdivisions.
+/// @param radius The circle'radius.
+/// @param tolerance The maximal distance in pixels in between the drawn circle
+///                  and the perfect one.
+/// @param view_scale The number of pixels per unit. It is the size of the
+///                   RenderTarget divided by the size of the View.
+Transformable Shape::Circle(float radius, float tolerance, float view_scale) {
+  return Circle(radius, CircleSubdivisions(radius, tolerance, view_scale));
+}
+
+/// @brief Return a centered 1x1x1 3D cube
+Transformable3D Shape::Cube() {
+  return FromVertexArray3D(GeometryCache::Default().Get(
+      {float(Generator::Cube)}, [] { return BuildCube(); }));
+}
+
+/// @brief A centered sphere of diameter 1.
+/// @param iteration
+///   Control the number of triangle used to make the sphere. It contains about
+///   \f$ 8 \times 3^{iteration} \f$ triangles: an icosahedron is subdivided
+///   into the closest number of the form \f$ 20 \times 4^{n} \f$. The
+///   vertices are shared in between the triangles.
+Transformable3D Shape::IcoSphere(int iteration) {
+  const int level = IcoSphereSubdivisions(std::max(iteration, 0));
+  return FromVertexArray3D(GeometryCache::Default().Get(
+      {float(Generator::IcoSphere), float(level)},
+      [&] { return BuildIcoSphere(level); }));
+}
+
+/// @brief A centered sphere of diameter 1, made of slices and stacks. The
+/// texture is mapped using the longitude and the latitude.
+/// @param slices The number of subdivisions around the Y axis.
+/// @param stacks The number of subdivisions from one pole to the other.
+Transformable3D Shape::UVSphere(int slices, int stacks) {
+  slices = std::max(slices, 3);
+  stacks = std::max(stacks, 2);
+  return FromVertexArray3D(GeometryCache::Default().Get(
+      {float(Generator::UVSphere), float(slices), float(stacks)},
+      [&] { return BuildUVSphere(slices, stacks); }));
+}
+
+/// @brief A centered cylinder of diameter 1 and height 1, along the Y axis.
+/// @param subdivisions The number of faces around the Y axis.
+Transformable3D Shape::Cylinder(int subdivisions) {
+  subdivisions = std::max(subdivisions, 3);
+  return FromVertexArray3D(GeometryCache::Default().Get(
+      {float(Generator::Cylinder), float(subdivisions)},
+      [&] { return BuildCylinder(subdivisions); }));
+}
+
+/// @brief A centered torus of diameter 1, around the Y axis.
+/// @param tube_radius The radius of the tube, in between 0 and 0.25.
+/// @param major_subdivisions The number of subdivisions around the Y axis.
+/// @param minor_subdivisions The number of subdivisions around the tube.
+Transformable3D Shape::Torus(float tube_radius,
+                             int major_subdivisions,
+                             int minor_subdivisions) {
+  tube_radius = glm::clamp(tube_radius, 0.F, 0.25F);  // NOLINT
+  major_subdivisions = std::max(major_subdivisions, 3);
+  minor_subdivisions = std::max(minor_subdivisions, 3);
+  return FromVertexArray3D(GeometryCache::Default().Get(
+      {float(Generator::Torus), tube_radius, float(major_subdivisions),
+       float(minor_subdivisions)},
+      [&] {
+        return BuildTorus(tube_radius, major_subdivisions, minor_subdivisions);
+      }));
+}
+
+/// @brief Return a centered 1x1 square in a 3D space.
+Transformable3D Shape::Plane() {
+  return FromVertexArray3D(GeometryCache::Default().Get(
+      {float(Generator::Plane)}, [] { return BuildPlane(); }));
+}
+
 /// @brief Return a bezier curve.
 /// @see https://en.wikipedia.org/wiki/Bézier_curve
 /// @param points The sequence of control points where the produced curve should
 /// pass by.
-/// @param subdivision The number of points in the output.
+/// @param subdivision The number of segments. The output has |subdivision| + 1
+/// points.
+/// @see smk::Bezier, to evaluate into a reused buffer.
 // static
 std::vector<glm::vec2> Shape::Bezier(const std::vector<glm::vec2>& points,
                                      size_t subdivision) {
-  std::vector<glm::vec2> path;
-  for (size_t index = 0; index < subdivision + 1; ++index) {
-    std::vector<glm::vec2> data = points;
-    float x = float(index) / float(subdivision);
-    while (data.size() >= 2) {
-      for (size_t i = 0; i < data.size() - 1; ++i) {
-        data[i] = glm::mix(data[i], data[i + 1], x);
-      }
-      data.resize(data.size() - 1);
-    }
-    path.push_back(data[0]);
+  if (points.empty()) {
+    return {};
   }
+  std::vector<glm::vec2> path(subdivision + 1);
+  smk::Bezier::Evaluate(points.data(), points.size(), subdivision, path.data());
   return path;
 }
 
@@ -214,92 +523,20 @@ std::vector<glm::vec2> Shape::Bezier(const std::vector<glm::vec2>& points,
 // static
 smk::Transformable Shape::Path(const std::vector<glm::vec2>& points,
                                float thickness) {
-  using namespace glm;
-  std::vector<glm::vec3> planes_left;
-  std::vector<glm::vec3> planes_right;
-
-  thickness *= 0.5F; // NOLINT
-  // Compute planes shifted by +/- |thickness| around lines:
-  // points[i] -- points[i+1]
-
-  for (size_t i = 1; i < points.size(); ++i) {
-    glm::vec3 plane_left =
-        cross(vec3(points[i - 1], 1.F), vec3(points[i - 0], 1.F));
-    glm::vec3 plane_right = plane_left;
-    plane_left.z -= thickness * length(vec2(plane_left.x, plane_left.y));
-    plane_right.z += thickness * length(vec2(plane_right.x, plane_right.y));
-    planes_left.push_back(plane_left);
-    planes_right.push_back(plane_right);
-  }
-
-  // Compute the intersection of plane[i] and plane[i+1]. It gives us the the
-  // outline of the shape to be filled.
-  std::vector<glm::vec2> points_left;
-  std::vector<glm::vec2> points_right;
-
-  // Cap begin.
-  {
-    glm::vec2 direction = normalize(points[1] - points[0]);
-    glm::vec2 normal = {direction.y, -direction.x};
-    points_left.push_back(points[0] - normal * thickness);
-    points_right.push_back(points[0] + normal * thickness);
-  }
-
-  size_t i = 0;
-  for (size_t j = 1; j < points.size() - 1; ++j) {
-    glm::vec3 intersection_left = cross(planes_left[i], planes_left[j]);
-    glm::vec3 intersection_right = cross(planes_right[i], planes_right[j]);
-    const float epsilon = 0.01F;
-    if (intersection_left.z * intersection_right.z < epsilon) {
-      continue;
-    }
-    intersection_left /= intersection_left.z;
-    intersection_right /= intersection_right.z;
-    auto left = glm::vec2(intersection_left);
-    auto right = glm::vec2(intersection_right);
-    // NOLINTNEXTLINE
-    if (glm::distance(left, right) > 10.F * thickness) {
-      auto middle = glm::vec2(left + right) * 0.5F; // NOLINT
-      // NOLINTNEXTLINE
-      auto dir = glm::normalize(glm::vec2(right - left)) * 5.F * thickness;
-      left = glm::vec3(middle - dir, 1.F);
-      right = glm::vec3(middle + dir, 1.F);
-    }
-    points_left.push_back(left);
-    points_right.push_back(right);
-    i = j;
-  }
-
-  // Cap end.
-  {
-    glm::vec2 direction = normalize(points[points.size() - 2] - points.back());
-    glm::vec2 normal = {direction.y, -direction.x};
-    points_left.push_back(points.back() + normal * thickness);
-    points_right.push_back(points.back() - normal * thickness);
-  }
-
-  std::vector<smk::Vertex> v;
-
-  // Fill using rectangles.
-  // ...-A--C-...  A = points_left[i]
-  //     |\ | ...  B = points_right[i]
-  //     | \| ...  C = points_left[i + 1]
-  // ...-B--D-...  D = points_right[i + 1];
-  for (size_t i = 1; i < points_left.size(); ++i) {
-    glm::vec2& A = points_left[i - 1];
-    glm::vec2& B = points_right[i - 1];
-    glm::vec2& C = points_left[i];
-    glm::vec2& D = points_right[i];
-
-    v.push_back({A, {0.0, 0.0}});
-    v.push_back({B, {0.0, 0.0}});
-    v.push_back({D, {0.0, 0.0}});
-    v.push_back({A, {0.0, 0.0}});
-    v.push_back({D, {0.0, 0.0}});
-    v.push_back({C, {0.0, 0.0}});
-  }
+  Stroker::Style style;
+  style.thickness = thickness;
+  return Path(points, style);
+}
 
-  return smk::Shape::FromVertexArray(smk::VertexArray(v));
+/// @brief Build a path along a sequence of connected lines.
+/// @params points The sequence of points the path is going through.
+/// @params style The thickness, joins and caps of the path.
+/// @see Stroker.
+// static
+smk::Transformable Shape::Path(const std::vector<glm::vec2>& points,
+                               const Stroker::Style& style) {
+  // Not cached: the key would be every points, which rarely repeat.
+  return FromVertexArray(BuildPath(points, style));
 }
 
 /// @brief Return a rounded centered rectangle.
@@ -309,51 +546,78 @@ smk::Transformable Shape::Path(const std::vector<glm::vec2>& points,
 smk::Transformable Shape::RoundedRectangle(float width,
                                            float height,
                                            float radius) {
-  radius = std::max(radius, 0.F);
-  radius = std::min(radius, width * 0.5F); // NOLINT
-  radius = std::min(radius, height * 0.5F); // NOLINT
+  return RoundedRectangle(width, height, radius, 10);  // NOLINT
+}
 
-  width = width * 0.5F - radius; // NOLINT
-  height = height * 0.5F - radius; // NOLINT
-  std::vector<smk::Vertex> v;
-  smk::Vertex p0 = {{0.F, 0.F}, {0.F, 0.F}};
-  smk::Vertex p1 = {{width + radius, -height}, {0.F, 0.F}};
-  smk::Vertex p2 = {{width + radius, height}, {0.F, 0.F}};
-
-  v.push_back(p0);
-  v.push_back(p1);
-  v.push_back(p2);
-
-  const float angle_delta = 2.0 * M_PI / 40.f;
-
-  auto center = glm::vec2(width, radius);
-  // NOLINTNEXTLINE
-  for (float angle = 0.F; angle < 2.F * M_PI; angle += angle_delta) {
-    if (angle > 0.75 * 2.F * M_PI) {  // NOLINT
-      center = glm::vec2(width, -height);
-    } else if (angle > 0.5 * 2.F * M_PI) {  // NOLINT
-      center = glm::vec2(-width, -height);
-    } else if (angle > 0.25 * 2.F * M_PI) {  // NOLINT
-      center = glm::vec2(-width, +height);
-    } else {
-      center = glm::vec2(+width, +height);
-    }
+/// @brief Return a rounded centered rectangle.
+/// @params width The width of the rectangle.
+/// @params height The height of the rectangle.
+/// @params radius The radius of the four corners.
+/// @params corner_subdivisions The number of triangles used for each corner.
+smk::Transformable Shape::RoundedRectangle(float width,
+                                           float height,
+                                           float radius,
+                                           int corner_subdivisions) {
+  const GeometryCache::Key key = {
+      float(Generator::RoundedRectangle),
+      width,
+      height,
+      radius,
+      float(corner_subdivisions),
+  };
+  return FromVertexArray(GeometryCache::Default().Get(key, [&] {
+    return BuildRoundedRectangle(width, height, radius, corner_subdivisions);
+  }));
+}
 
-    p1 = p2;
-    p2 = {center + radius * glm::vec2(std::cos(angle), std::sin(angle)), {0.F, 0.F}};
+/// @brief Return a rounded centered rectangle, whose corners are tessellated
+/// according to their size on screen.
+/// @see Shape::CircleSubdivisions.
+/// @params width The width of the rectangle.
+/// @params height The height of the rectangle.
+/// @params radius The radius of the four corners.
+/// @params tolerance The maximal distance in pixels in between the drawn
+///                   corners and the perfect ones.
+/// @params view_scale The number of pixels per unit. It is the size of the
+///                    RenderTarget divided by the size of the View.
+smk::Transformable Shape::RoundedRectangle(float width,
+                                           float height,
+                                           float radius,
+                                           float tolerance,
+                                           float view_scale) {
+  const int subdivisions = CircleSubdivisions(radius, tolerance, view_scale);
+  return RoundedRectangle(width, height, radius, std::max(1, subdivisions / 4));
+}
 
-    v.push_back(p0);
-    v.push_back(p1);
-    v.push_back(p2);
+/// @brief The number of segments needed to draw a circle, so that it doesn't
+/// deviate from the perfect circle by more than |tolerance| pixels.
+///
+/// The result is rounded up to a power of two. It only changes when the size of
+/// the circle on screen crosses a level of detail threshold, so that shapes
+/// generated from it are reused from the GeometryCache.
+/// @params radius The radius of the circle.
+/// @params tolerance The maximal distance in pixels.
+/// @params view_scale The number of pixels per unit. It is the size of the
+///                    RenderTarget divided by the size of the View.
+// static
+int Shape::CircleSubdivisions(float radius, float tolerance, float view_scale) {
+  constexpr int min_subdivisions = 8;
+  constexpr int max_subdivisions = 4096;
+  const float screen_radius = std::abs(radius * view_scale);
+  tolerance = std::max(tolerance, 0.01F);  // NOLINT
+  if (screen_radius <= tolerance) {
+    return min_subdivisions;
   }
 
-  p1 = p2;
-  p2 = {{width + radius, -height}, {0.F, 0.F}};
-  v.push_back(p0);
-  v.push_back(p1);
-  v.push_back(p2);
-
-  return smk::Shape::FromVertexArray(smk::VertexArray(v));
+  // A chord spanning |angle| is at distance r * (1 - cos(angle / 2)) from the
+  // circle.
+  const float angle = 2.F * std::acos(1.F - tolerance / screen_radius);
+  const float needed = float(2.0 * M_PI) / angle;
+  int subdivisions = min_subdivisions;
+  while (float(subdivisions) < needed && subdivisions < max_subdivisions) {
+    subdivisions *= 2;
+  }
+  return subdivisions;
 }
 
 }  // namespace smk
@@ -0,0 +1,281 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <smk/Color.hpp>
+#include <smk/Context.hpp>
+#include <smk/RenderTarget.hpp>
+#include <smk/Shader.hpp>
+#include <smk/ShapeBatch.hpp>
+
+namespace smk {
+
+namespace {
+
+// Evaluate the signed distance to a rounded box, and derive the coverage of
+// the pixel from the distance's screen space derivative.
+ShaderProgram& ShapeBatchShaderProgram() {
+  static ContextResource<ShaderProgram> shader_program([] {
+    auto vertex_shader = Shader::FromString(R"(
+      layout(location = 0) in vec2 space_position;
+      layout(location = 1) in vec2 local_position;
+      layout(location = 2) in vec2 half_size;
+      layout(location = 3) in vec2 radius_border;
+      layout(location = 4) in vec4 fill_color;
+      layout(location = 5) in vec4 border_color;
+
+      uniform mat4 projection;
+      uniform mat4 view;
+
+      out vec2 f_local_position;
+      flat out vec2 f_half_size;
+      flat out vec2 f_radius_border;
+      flat out vec4 f_fill_color;
+      flat out vec4 f_border_color;
+
+      void main() {
+        f_local_position = local_position;
+        f_half_size = half_size;
+        f_radius_border = radius_border;
+        f_fill_color = fill_color;
+        f_border_color = border_color;
+        gl_Position = projection * view * vec4(space_position, 0.0, 1.0);
+      }
+    )",
+                                            GL_VERTEX_SHADER);
+
+    auto fragment_shader = Shader::FromString(R"(
+      in vec2 f_local_position;
+      flat in vec2 f_half_size;
+      flat in vec2 f_radius_border;
+      flat in vec4 f_fill_color;
+      flat in vec4 f_border_color;
+      uniform vec4 color;
+      out vec4 out_color;
+
+      float RoundedBox(vec2 position, vec2 half_size, float radius) {
+        vec2 q = abs(position) - half_size + radius;
+        return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;
+      }
+
+      void main() {
+        float radius = f_radius_border.x;
+        float border = f_radius_border.y;
+        float distance = RoundedBox(f_local_position, f_half_size, radius);
+        float width = max(fwidth(distance), 0.0001);
+        float coverage = clamp(0.5 - distance / width, 0.0, 1.0);
+        // Without a border, the antialiased edge must keep the fill color.
+        float fill = border > 0.0
+                         ? clamp(0.5 - (distance + border) / width, 0.0, 1.0)
+                         : 1.0;
+        vec4 shape_color = mix(f_border_color, f_fill_color, fill);
+        out_color = vec4(shape_color.rgb, shape_color.a * coverage) * color;
+      }
+    )",
+                                              GL_FRAGMENT_SHADER);
+
+    return LinkShaderProgram(vertex_shader, fragment_shader,
+                             /*textured=*/false);
+  });
+  return shader_program.Get();
+}
+
+}  // namespace
+
+/// @brief An empty ShapeBatch.
+ShapeBatch::ShapeBatch() = default;
+
+/// @brief Copy constructor. The copy uses its own GPU buffer.
+ShapeBatch::ShapeBatch(const ShapeBatch& other)
+    : primitives_(other.primitives_), blend_mode_(other.blend_mode_) {}
+
+/// @brief Copy operator. The copy uses its own GPU buffer.
+ShapeBatch& ShapeBatch::operator=(const ShapeBatch& other) {
+  primitives_ = other.primitives_;
+  blend_mode_ = other.blend_mode_;
+  modified_ = true;
+  return *this;
+}
+
+/// @brief Add a filled circle.
+/// @param center The center of the circle.
+/// @param radius The radius of the circle.
+/// @return The index of the new shape.
+size_t ShapeBatch::AddCircle(const glm::vec2& center, float radius) {
+  Primitive primitive;
+  primitive.center = center;
+  primitive.axis = {1.F, 0.F};
+  primitive.half_size = {radius, radius};
+  primitive.radius = radius;
+  return Add(primitive);
+}
+
+/// @brief Add a filled rounded rectangle.
+/// @param center The center of the rectangle.
+/// @param size The width and height of the rectangle.
+/// @param radius The radius of the four corners.
+/// @return The index of the new shape.
+size_t ShapeBatch::AddRoundedRectangle(const glm::vec2& center,
+                                       const glm::vec2& size,
+                                       float radius) {
+  Primitive primitive;
+  primitive.center = center;
+  primitive.axis = {1.F, 0.F};
+  primitive.half_size = size * 0.5F;  // NOLINT
+  primitive.radius =
+      glm::clamp(radius, 0.F, std::min(primitive.half_size.x,  //
+                                       primitive.half_size.y));
+  return Add(primitive);
+}
+
+/// @brief Add a line with a given thickness.
+/// @see Shape::Line.
+/// @param a The first end.
+/// @param b The second end.
+/// @param thickness The line thickness.
+/// @return The index of the new shape.
+size_t ShapeBatch::AddLine(const glm::vec2& a,
+                           const glm::vec2& b,
+                           float thickness) {
+  const float length = glm::distance(a, b);
+  Primitive primitive;
+  primitive.center = (a + b) * 0.5F;  // NOLINT
+  primitive.axis = length > 0.F ? (b - a) / length : glm::vec2(1.F, 0.F);
+  primitive.half_size = glm::vec2(length, thickness) * 0.5F;  // NOLINT
+  return Add(primitive);
+}
+
+/// @brief Set the fill color of a shape.
+void ShapeBatch::SetColor(size_t index, const glm::vec4& color) {
+  primitives_[index].color = Color::Pack(color);
+  modified_ = true;
+}
+
+/// @brief Add a border on the inside of a shape.
+/// @param index The shape to be modified.
+/// @param width The width of the border.
+/// @param color The color of the border.
+void ShapeBatch::SetBorder(size_t index, float width, const glm::vec4& color) {
+  primitives_[index].border = width;
+  primitives_[index].border_color = Color::Pack(color);
+  modified_ = true;
+}
+
+/// @brief Move a shape.
+void ShapeBatch::Move(size_t index, const glm::vec2& move) {
+  primitives_[index].center += move;
+  modified_ = true;
+}
+
+/// @brief Remove every shapes.
+void ShapeBatch::Clear() {
+  primitives_.clear();
+  modified_ = true;
+}
+
+/// @brief The number of shapes.
+size_t ShapeBatch::size() const {
+  return primitives_.size();
+}
+
+/// @brief Set the blending mode used to draw the shapes.
+void ShapeBatch::SetBlendMode(const BlendMode& blend_mode) {
+  blend_mode_ = blend_mode;
+}
+
+size_t ShapeBatch::Add(const Primitive& primitive) {
+  primitives_.push_back(primitive);
+  modified_ = true;
+  return primitives_.size() - 1;
+}
+
+// Compute the quad of every shapes into |vertices_|. The quads are enlarged by
+// |padding|, so that the antialiased edges aren't clipped.
+void ShapeBatch::GenerateVertices(float padding,
+                                  Rectangle* bounding_box) const {
+  vertices_.resize(4 * primitives_.size());
+
+  glm::vec2 min(+std::numeric_limits<float>::max());
+  glm::vec2 max(-std::numeric_limits<float>::max());
+  Vertex2DShape* vertex = vertices_.data();
+  for (const Primitive& primitive : primitives_) {
+    const glm::vec2 extent = primitive.half_size + padding;
+    const glm::vec2 axis_x = primitive.axis;
+    const glm::vec2 axis_y = {-axis_x.y, axis_x.x};
+    const glm::vec2 corners[4] = {
+        {-extent.x, -extent.y},
+        {-extent.x, +extent.y},
+        {+extent.x, +extent.y},
+        {+extent.x, -extent.y},
+    };
+    for (const glm::vec2& corner : corners) {
+      vertex->space_position =
+          primitive.center + axis_x * corner.x + axis_y * corner.y;
+      vertex->local_position = corner;
+      vertex->half_size = primitive.half_size;
+      vertex->radius = primitive.radius;
+      vertex->border = primitive.border;
+      vertex->color = primitive.color;
+      vertex->border_color = primitive.border_color;
+      min = glm::min(min, vertex->space_position);
+      max = glm::max(max, vertex->space_position);
+      ++vertex;
+    }
+  }
+
+  *bounding_box = {min.x, min.y, max.x, max.y};
+}
+
+/// @brief Draw every shapes, using a single draw call.
+void ShapeBatch::Draw(RenderTarget& target, RenderState state) const {
+  if (primitives_.empty()) {
+    return;
+  }
+
+  // The antialiasing needs one pixel around the shapes. Estimate the size of a
+  // pixel in the shapes' coordinates.
+  float padding = 1.F;
+  const View& view = target.view();
+  const float scale = glm::length(glm::vec2(state.view[0]));
+  if (view.width_ != 0.F && target.width() != 0 && scale != 0.F) {
+    padding = std::abs(view.width_) / (float(target.width()) * scale);
+  }
+
+  if (modified_ || std::abs(padding - padding_) > 0.01F * padding) {  // NOLINT
+    modified_ = false;
+    padding_ = padding;
+
+    Rectangle bounding_box;
+    GenerateVertices(padding, &bounding_box);
+
+    // The indices only depend on the number of shapes. They are regenerated
+    // when the capacity grows.
+    const size_t size = primitives_.size();
+    if (vertex_array_capacity_ < size) {
+      vertex_array_capacity_ = std::max(size, 2 * vertex_array_capacity_);
+      std::vector<GLuint> indices(6 * vertex_array_capacity_);
+      for (size_t i = 0; i < vertex_array_capacity_; ++i) {
+        const auto base = GLuint(4 * i);
+        indices[6 * i + 0] = base + 0;
+        indices[6 * i + 1] = base + 1;
+        indices[6 * i + 2] = base + 2;
+        indices[6 * i + 3] = base + 0;
+        indices[6 * i + 4] = base + 2;
+        indices[6 * i + 5] = base + 3;
+      }
+      vertex_array_ = VertexArray(vertices_, indices);
+    }
+    vertex_array_.Update(vertices_, 6 * size, bounding_box);
+  }
+
+  state.shader_program = ShapeBatchShaderProgram();
+  state.texture = Texture();
+  state.vertex_array = vertex_array_;
+  state.blend_mode = blend_mode_;
+  target.Draw(state);
+}
+
+}  // namespace smk
@@ -0,0 +1,270 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <cmath>
+#include <smk/RenderTarget.hpp>
+#include <smk/SpatialScene.hpp>
+
+namespace smk {
+
+namespace {
+
+int64_t CellKey(int x, int y) {
+  return (int64_t(x) << 32) | int64_t(uint32_t(y));  // NOLINT
+}
+
+}  // namespace
+
+bool SpatialScene::CellRange::operator==(const CellRange& other) const {
+  return left == other.left && top == other.top && right == other.right &&
+         bottom == other.bottom;
+}
+
+/// @brief An empty SpatialScene, using 256x256 cells.
+SpatialScene::SpatialScene() = default;
+
+/// @brief An empty SpatialScene.
+/// @param cell_size The size of the cells of the grid. A good value is a few
+///                  times the size of a typical object.
+SpatialScene::SpatialScene(float cell_size) : cell_size_(cell_size) {}
+
+/// @brief Add an object to the scene.
+/// @param object The object to be added. It is copied.
+/// @return The handle identifying the object in the scene.
+SpatialScene::Handle SpatialScene::Add(const Transformable& object) {
+  Handle handle = 0;
+  if (free_handles_.empty()) {
+    handle = Handle(objects_.size());
+    objects_.emplace_back();
+    query_stamps_.push_back(0);
+  } else {
+    handle = free_handles_.back();
+    free_handles_.pop_back();
+  }
+
+  objects_[handle].transformable = object;
+  objects_[handle].sequence = next_sequence_++;
+  objects_[handle].alive = true;
+  Insert(handle);
+  return handle;
+}
+
+/// @brief Remove an object from the scene. Its handle might be reused by future
+/// calls to SpatialScene::Add. Removing an object twice does nothing.
+/// @param handle The object to be removed.
+void SpatialScene::Remove(Handle handle) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  Erase(handle);
+  objects_[handle] = Object();
+  free_handles_.push_back(handle);
+}
+
+/// @brief Access an object of the scene.
+/// @param handle The object to be accessed.
+const Transformable& SpatialScene::Get(Handle handle) const {
+  return objects_[handle].transformable;
+}
+
+/// @brief Replace an object of the scene.
+/// @param handle The object to be replaced.
+/// @param object The new object.
+void SpatialScene::Set(Handle handle, const Transformable& object) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  objects_[handle].transformable = object;
+  Update(handle);
+}
+
+/// @brief Set the position of an object of the scene.
+/// @see Transformable::SetPosition.
+/// @param handle The object to be moved.
+/// @param position The new position.
+void SpatialScene::SetPosition(Handle handle, const glm::vec2& position) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  objects_[handle].transformable.SetPosition(position);
+  Update(handle);
+}
+
+/// @brief Move an object of the scene.
+/// @see Transformable::Move.
+/// @param handle The object to be moved.
+/// @param move The increment of position.
+void SpatialScene::Move(Handle handle, const glm::vec2& move) {
+  if (!IsAlive(handle)) {
+    return;
+  }
+  objects_[handle].transformable.Move(move);
+  Update(handle);
+}
+
+/// @brief Return the objects whose bounding box intersects |area|.
+/// @param area The area, in the scene's coordinates.
+/// @return The objects, from the topmost to the bottommost.
+std::vector<SpatialScene::Handle> SpatialScene::Query(
+    const Rectangle& area) const {
+  std::vector<Handle> out;
+  Collect(area, &out);
+  SortByInsertion(&out);
+  std::reverse(out.begin(), out.end());
+  return out;
+}
+
+/// @brief Return the objects whose bounding box contains |point|. This is
+/// useful for picking objects under the mouse cursor.
+/// @param point The point, in the scene's coordinates.
+/// @return The objects, from the topmost to the bottommost.
+std::vector<SpatialScene::Handle> SpatialScene::Query(
+    const glm::vec2& point) const {
+  return Query(Rectangle{point.x, point.y, point.x, point.y});
+}
+
+/// @brief The number of objects in the scene.
+size_t SpatialScene::size() const {
+  return objects_.size() - free_handles_.size();
+}
+
+/// @brief Draw the objects intersecting the target's View.
+void SpatialScene::Draw(RenderTarget& target, RenderState state) const {
+  const View& view = target.view();
+  Rectangle area = {
+      std::min(view.Left(), view.Right()),
+      std::min(view.Top(), view.Bottom()),
+      std::max(view.Left(), view.Right()),
+      std::max(view.Top(), view.Bottom()),
+  };
+
+  // Express the View in the scene's coordinates.
+  if (state.view != glm::mat4(1.F)) {
+    area = TransformBoundingBox(area, glm::inverse(state.view));
+  }
+
+  std::vector<Handle> visible;
+  Collect(area, &visible);
+  SortByInsertion(&visible);
+  for (Handle handle : visible) {
+    objects_[handle].transformable.Draw(target, state);
+  }
+}
+
+bool SpatialScene::IsAlive(Handle handle) const {
+  return handle < objects_.size() && objects_[handle].alive;
+}
+
+// Handles are recycled, so they don't reflect the insertion order.
+void SpatialScene::SortByInsertion(std::vector<Handle>* handles) const {
+  std::sort(handles->begin(), handles->end(), [&](Handle a, Handle b) {
+    return objects_[a].sequence < objects_[b].sequence;
+  });
+}
+
+SpatialScene::CellRange SpatialScene::ComputeCellRange(
+    const Rectangle& area) const {
+  CellRange range;
+  range.left = int(std::floor(area.left / cell_size_));
+  range.top = int(std::floor(area.top / cell_size_));
+  range.right = int(std::floor(area.right / cell_size_));
+  range.bottom = int(std::floor(area.bottom / cell_size_));
+  return range;
+}
+
+void SpatialScene::Insert(Handle handle) {
+  Object& object = objects_[handle];
+  object.bounding_box =
+      TransformBoundingBox(object.transformable.vertex_array().bounding_box(),
+                           object.transformable.transformation());
+  object.cells = ComputeCellRange(object.bounding_box);
+  for (int y = object.cells.top; y <= object.cells.bottom; ++y) {
+    for (int x = object.cells.left; x <= object.cells.right; ++x) {
+      cells_[CellKey(x, y)].push_back(handle);
+    }
+  }
+}
+
+void SpatialScene::Erase(Handle handle) {
+  const CellRange& cells = objects_[handle].cells;
+  for (int y = cells.top; y <= cells.bottom; ++y) {
+    for (int x = cells.left; x <= cells.right; ++x) {
+      auto it = cells_.find(CellKey(x, y));
+      if (it == cells_.end()) {
+        continue;
+      }
+      auto& handles = it->second;
+      handles.erase(std::find(handles.begin(), handles.end(), handle));
+      if (handles.empty()) {
+        cells_.erase(it);
+      }
+    }
+  }
+  objects_[handle].cells = CellRange();
+}
+
+// Update the bounding box of an object. The grid is modified only when the
+// object crosses cells boundaries.
+void SpatialScene::Update(Handle handle) {
+  Object& object = objects_[handle];
+  const Rectangle bounding_box =
+      TransformBoundingBox(object.transformable.vertex_array().bounding_box(),
+                           object.transformable.transformation());
+  if (ComputeCellRange(bounding_box) == object.cells) {
+    object.bounding_box = bounding_box;
+    return;
+  }
+  Erase(handle);
+  Insert(handle);
+}
+
+// Append to |out| the objects intersecting |area|, each one only once.
+void SpatialScene::Collect(const Rectangle& area,
+                           std::vector<Handle>* out) const {
+  if (++query_stamp_ == 0) {
+    std::fill(query_stamps_.begin(), query_stamps_.end(), 0);
+    query_stamp_ = 1;
+  }
+
+  auto visit = [&](const std::vector<Handle>& handles) {
+    for (Handle handle : handles) {
+      if (query_stamps_[handle] == query_stamp_) {
+        continue;
+      }
+      query_stamps_[handle] = query_stamp_;
+      if (objects_[handle].bounding_box.Intersects(area)) {
+        out->push_back(handle);
+      }
+    }
+  };
+
+  // When the area covers more cells than there are non-empty ones, iterate
+  // over the non-empty ones instead.
+  const CellRange range = ComputeCellRange(area);
+  const int64_t area_cells = int64_t(range.right - range.left + 1) *
+                             int64_t(range.bottom - range.top + 1);
+  if (area_cells > int64_t(cells_.size())) {
+    for (const auto& cell : cells_) {
+      const int x = int(cell.first >> 32);  // NOLINT
+      const int y = int(int32_t(uint32_t(cell.first)));
+      if (x >= range.left && x <= range.right &&  //
+          y >= range.top && y <= range.bottom) {
+        visit(cell.second);
+      }
+    }
+    return;
+  }
+
+  for (int y = range.top; y <= range.bottom; ++y) {
+    for (int x = range.left; x <= range.right; ++x) {
+      auto it = cells_.find(CellKey(x, y));
+      if (it != cells_.end()) {
+        visit(it->second);
+      }
+    }
+  }
+}
+
+}  // namespace smk
@@ -3,6 +3,7 @@
 // the LICENSE file.
 
 #include <smk/Framebuffer.hpp>
+#include <smk/GeometryCache.hpp>
 #include <smk/OpenGL.hpp>
 #include <smk/Shader.hpp>
 #include <smk/Sprite.hpp>
@@ -11,6 +12,40 @@
 
 namespace smk {
 
+namespace {
+
+// Return a quad of size (width, height), displaying the texture area
+// [left,right]x[top,bottom]. Sprites displaying the same area share the same
+// VertexArray, instead of allocating their own GPU buffers.
+VertexArray Quad(float width,
+                 float height,
+                 float left,
+                 float top,
+                 float right,
+                 float bottom) {
+  const GeometryCache::Key key = {
+      float(GeometryCache::Generator::SpriteQuad),
+      width,
+      height,
+      left,
+      top,
+      right,
+      bottom,
+  };
+  return GeometryCache::Default().Get(key, [&] {
+    return VertexArray(std::vector<Vertex>({
+        {{0.F, 0.F}, {left, top}},
+        {{0.F, height}, {left, bottom}},
+        {{width, height}, {right, bottom}},
+        {{0.F, 0.F}, {left, top}},
+        {{width, height}, {right, bottom}},
+        {{width, 0.F}, {right, top}},
+    }));
+  });
+}
+
+}  // namespace
+
 /// @brief A Sprite for drawing a texture.
 /// @param texture The Texture to be displayed.
 Sprite::Sprite(const Texture& texture) : Sprite() {
@@ -35,14 +70,8 @@ Sprite::Sprite(Framebuffer& framebuffer) {
   float b = 1.F;
   auto www = float(framebuffer.color_texture().width());
   auto hhh = float(framebuffer.color_texture().height());
-  SetVertexArray(VertexArray(std::vector<Vertex>({
-      {{0.F, 0.F}, {l, b}},
-      {{0.F, hhh}, {l, t}},
-      {{www, hhh}, {r, t}},
-      {{0.F, 0.F}, {l, b}},
-      {{www, hhh}, {r, t}},
-      {{www, 0.F}, {r, b}},
-  })));
+  // The framebuffer's rows are stored from bottom to top.
+  SetVertexArray(Quad(www, hhh, l, b, r, t));
 }
 
 /// @brief Update the sprite's texture.
@@ -67,14 +96,7 @@ void Sprite::SetTextureRectangle(const Rectangle& rectangle) {
   float b = (rectangle.bottom - 0.5F) / texture().height();  // NOLINT
   float www = rectangle.width();
   float hhh = rectangle.height();
-  SetVertexArray(VertexArray(std::vector<Vertex>({
-      {{0.F, 0.F}, {l, t}},
-      {{0.F, hhh}, {l, b}},
-      {{www, hhh}, {r, b}},
-      {{0.F, 0.F}, {l, t}},
-      {{www, hhh}, {r, b}},
-      {{www, 0.F}, {r, t}},
-  })));
+  SetVertexArray(Quad(www, hhh, l, t, r, b));
 }
 
 }  // namespace smk
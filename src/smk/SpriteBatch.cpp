@@ -0,0 +1,308 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <smk/Color.hpp>
+#include <smk/Context.hpp>
+#include <smk/RenderTarget.hpp>
+#include <smk/Shader.hpp>
+#include <smk/SpriteBatch.hpp>
+
+namespace smk {
+
+namespace {
+
+// The 2D shader, with an additional color per vertex.
+ShaderProgram& SpriteBatchShaderProgram() {
+  static ContextResource<ShaderProgram> shader_program([] {
+    auto vertex_shader = Shader::FromString(R"(
+      layout(location = 0) in vec2 space_position;
+      layout(location = 1) in vec2 texture_position;
+      layout(location = 2) in vec4 vertex_color;
+
+      uniform mat4 projection;
+      uniform mat4 view;
+
+      out vec2 f_texture_position;
+      out vec4 f_color;
+
+      void main() {
+        f_texture_position = texture_position;
+        f_color = vertex_color;
+        gl_Position = projection * view * vec4(space_position, 0.0, 1.0);
+      }
+    )",
+                                            GL_VERTEX_SHADER);
+
+    auto fragment_shader = Shader::FromString(R"(
+      in vec2 f_texture_position;
+      in vec4 f_color;
+      uniform sampler2D texture_0;
+      uniform vec4 color;
+      out vec4 out_color;
+
+      void main() {
+        out_color = texture(texture_0, f_texture_position) * f_color * color;
+      }
+    )",
+                                              GL_FRAGMENT_SHADER);
+
+    return LinkShaderProgram(vertex_shader, fragment_shader,
+                             /*textured=*/true);
+  });
+  return shader_program.Get();
+}
+
+}  // namespace
+
+/// @brief An empty SpriteBatch, without texture.
+SpriteBatch::SpriteBatch() = default;
+
+/// @brief An empty SpriteBatch.
+/// @param texture The texture shared by every sprites. Use a texture atlas and
+///                SpriteBatch::SetTextureRectangle to display different images.
+SpriteBatch::SpriteBatch(const Texture& texture) : texture_(texture) {}
+
+/// @brief Add a sprite displaying the whole texture.
+/// @param position The position of the sprite.
+/// @return The index of the new sprite.
+size_t SpriteBatch::Add(const glm::vec2& position) {
+  return Add(position, {
+                           0.F,
+                           0.F,
+                           float(texture_.width()),
+                           float(texture_.height()),
+                       });
+}
+
+/// @brief Add a sprite displaying a part of the texture.
+/// @param position The position of the sprite.
+/// @param texture_rectangle The area of the texture to be displayed, in pixels.
+/// @return The index of the new sprite.
+size_t SpriteBatch::Add(const glm::vec2& position,
+                        const Rectangle& texture_rectangle) {
+  const size_t index = positions_.size();
+  positions_.push_back(position);
+  rotations_.emplace_back(1.F, 0.F);
+  scales_.emplace_back(1.F, 1.F);
+  centers_.emplace_back(0.F, 0.F);
+  sizes_.emplace_back();
+  texture_coordinates_.emplace_back();
+  colors_.push_back(0xFFFFFFFF);  // NOLINT
+  SetTextureRectangle(index, texture_rectangle);
+  return index;
+}
+
+/// @brief Remove a sprite. To avoid moving every following sprites, the last
+/// sprite is moved to |index|.
+/// @param index The sprite to be removed. Out of range indices are ignored.
+void SpriteBatch::Remove(size_t index) {
+  if (index >= positions_.size()) {
+    return;
+  }
+  const size_t last = positions_.size() - 1;
+  positions_[index] = positions_[last];
+  rotations_[index] = rotations_[last];
+  scales_[index] = scales_[last];
+  centers_[index] = centers_[last];
+  sizes_[index] = sizes_[last];
+  texture_coordinates_[index] = texture_coordinates_[last];
+  colors_[index] = colors_[last];
+
+  positions_.pop_back();
+  rotations_.pop_back();
+  scales_.pop_back();
+  centers_.pop_back();
+  sizes_.pop_back();
+  texture_coordinates_.pop_back();
+  colors_.pop_back();
+}
+
+/// @brief Remove every sprites.
+void SpriteBatch::Clear() {
+  positions_.clear();
+  rotations_.clear();
+  scales_.clear();
+  centers_.clear();
+  sizes_.clear();
+  texture_coordinates_.clear();
+  colors_.clear();
+}
+
+/// @brief Preallocate memory for |capacity| sprites.
+void SpriteBatch::Reserve(size_t capacity) {
+  positions_.reserve(capacity);
+  rotations_.reserve(capacity);
+  scales_.reserve(capacity);
+  centers_.reserve(capacity);
+  sizes_.reserve(capacity);
+  texture_coordinates_.reserve(capacity);
+  colors_.reserve(capacity);
+  vertices_.reserve(4 * capacity);
+}
+
+/// @brief The number of sprites.
+size_t SpriteBatch::size() const {
+  return positions_.size();
+}
+
+/// @brief Set the position of a sprite.
+/// @see Transformable::SetPosition.
+void SpriteBatch::SetPosition(size_t index, const glm::vec2& position) {
+  positions_[index] = position;
+}
+
+/// @brief Set the rotation of a sprite.
+/// @see Transformable::SetRotation.
+void SpriteBatch::SetRotation(size_t index, float rotation) {
+  const float angle = -rotation * (2.F * 3.1415F / 360.F);  // NOLINT
+  rotations_[index] = {std::cos(angle), std::sin(angle)};
+}
+
+/// @brief Set the scale of a sprite.
+/// @see Transformable::SetScale.
+void SpriteBatch::SetScale(size_t index, const glm::vec2& scale) {
+  scales_[index] = scale;
+}
+
+/// @brief Set the center of a sprite.
+/// @see Transformable::SetCenter.
+void SpriteBatch::SetCenter(size_t index, const glm::vec2& center) {
+  centers_[index] = center;
+}
+
+/// @brief Set the color of a sprite. It is multiplied with the texture.
+/// @see Transformable::SetColor.
+void SpriteBatch::SetColor(size_t index, const glm::vec4& color) {
+  colors_[index] = Color::Pack(color);
+}
+
+/// @brief Set the area of the texture displayed by a sprite.
+/// @see Sprite::SetTextureRectangle.
+/// @param index The sprite to be modified.
+/// @param texture_rectangle The area of the texture, in pixels.
+void SpriteBatch::SetTextureRectangle(size_t index,
+                                      const Rectangle& texture_rectangle) {
+  sizes_[index] = {texture_rectangle.width(), texture_rectangle.height()};
+  if (texture_.width() == 0 || texture_.height() == 0) {
+    texture_coordinates_[index] = {0.F, 0.F, 1.F, 1.F};
+    return;
+  }
+  const float width = float(texture_.width());
+  const float height = float(texture_.height());
+  texture_coordinates_[index] = {
+      (texture_rectangle.left + 0.5F) / width,     // NOLINT
+      (texture_rectangle.top + 0.5F) / height,     // NOLINT
+      (texture_rectangle.right - 0.5F) / width,    // NOLINT
+      (texture_rectangle.bottom - 0.5F) / height,  // NOLINT
+  };
+}
+
+/// @brief Set the texture shared by every sprites. The texture rectangles are
+/// kept, in pixels.
+void SpriteBatch::SetTexture(const Texture& texture) {
+  const bool rescale = texture_.width() && texture_.height() &&  //
+                       texture.width() && texture.height();
+  const float scale_x = float(texture_.width()) / float(texture.width());
+  const float scale_y = float(texture_.height()) / float(texture.height());
+  texture_ = texture;
+  if (!rescale) {
+    return;
+  }
+  for (auto& coordinates : texture_coordinates_) {
+    coordinates.x *= scale_x;
+    coordinates.y *= scale_y;
+    coordinates.z *= scale_x;
+    coordinates.w *= scale_y;
+  }
+}
+
+/// @brief Set the blending mode used to draw the sprites.
+void SpriteBatch::SetBlendMode(const BlendMode& blend_mode) {
+  blend_mode_ = blend_mode;
+}
+
+// Compute the 4 vertices of every sprites into |vertices_|. The loop only reads
+// and writes contiguous arrays, without branches.
+void SpriteBatch::GenerateVertices(Rectangle* bounding_box) const {
+  const size_t size = positions_.size();
+  vertices_.resize(4 * size);
+
+  glm::vec2 min(+std::numeric_limits<float>::max());
+  glm::vec2 max(-std::numeric_limits<float>::max());
+  Vertex2DColor* vertex = vertices_.data();
+  for (size_t i = 0; i < size; ++i, vertex += 4) {
+    const glm::vec2 axis_x = rotations_[i] * scales_[i].x;
+    const glm::vec2 axis_y =
+        glm::vec2(-rotations_[i].y, rotations_[i].x) * scales_[i].y;
+    const glm::vec2 origin =
+        positions_[i] - axis_x * centers_[i].x - axis_y * centers_[i].y;
+    const glm::vec2 width = axis_x * sizes_[i].x;
+    const glm::vec2 height = axis_y * sizes_[i].y;
+    const glm::vec4& uv = texture_coordinates_[i];
+
+    vertex[0].space_position = origin;
+    vertex[1].space_position = origin + height;
+    vertex[2].space_position = origin + width + height;
+    vertex[3].space_position = origin + width;
+    vertex[0].texture_position = {uv.x, uv.y};
+    vertex[1].texture_position = {uv.x, uv.w};
+    vertex[2].texture_position = {uv.z, uv.w};
+    vertex[3].texture_position = {uv.z, uv.y};
+    vertex[0].color = colors_[i];
+    vertex[1].color = colors_[i];
+    vertex[2].color = colors_[i];
+    vertex[3].color = colors_[i];
+
+    min = glm::min(min, glm::min(glm::min(vertex[0].space_position,
+                                          vertex[1].space_position),
+                                 glm::min(vertex[2].space_position,
+                                          vertex[3].space_position)));
+    max = glm::max(max, glm::max(glm::max(vertex[0].space_position,
+                                          vertex[1].space_position),
+                                 glm::max(vertex[2].space_position,
+                                          vertex[3].space_position)));
+  }
+
+  *bounding_box = {min.x, min.y, max.x, max.y};
+}
+
+/// @brief Draw every sprites, using a single draw call.
+void SpriteBatch::Draw(RenderTarget& target, RenderState state) const {
+  if (positions_.empty()) {
+    return;
+  }
+
+  Rectangle bounding_box;
+  GenerateVertices(&bounding_box);
+
+  // The indices only depend on the number of sprites. They are regenerated
+  // when the capacity grows.
+  const size_t size = positions_.size();
+  if (vertex_array_capacity_ < size) {
+    vertex_array_capacity_ = std::max(size, 2 * vertex_array_capacity_);
+    std::vector<GLuint> indices(6 * vertex_array_capacity_);
+    for (size_t i = 0; i < vertex_array_capacity_; ++i) {
+      const auto base = GLuint(4 * i);
+      indices[6 * i + 0] = base + 0;
+      indices[6 * i + 1] = base + 1;
+      indices[6 * i + 2] = base + 2;
+      indices[6 * i + 3] = base + 0;
+      indices[6 * i + 4] = base + 2;
+      indices[6 * i + 5] = base + 3;
+    }
+    vertex_array_ = VertexArray(vertices_, indices);
+  }
+  vertex_array_.Update(vertices_, 6 * size, bounding_box);
+
+  state.shader_program = SpriteBatchShaderProgram();
+  state.texture = texture_;
+  state.vertex_array = vertex_array_;
+  state.blend_mode = blend_mode_;
+  target.Draw(state);
+}
+
+}  // namespace smk
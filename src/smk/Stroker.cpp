@@ -0,0 +1,249 @@
+// Copyright 2019 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+
+#include <algorithm>
+#include <cmath>
+#include <smk/Stroker.hpp>
+
+namespace smk {
+
+namespace {
+
+constexpr float pi = 3.14159265358979323846F;  // NOLINT
+
+// Rotate by +90 degrees.
+glm::vec2 Perpendicular(const glm::vec2& v) {
+  return {-v.y, v.x};
+}
+
+float Cross(const glm::vec2& a, const glm::vec2& b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+}  // namespace
+
+/// @brief A Stroker using the default Style.
+Stroker::Stroker() : Stroker(Style()) {}
+
+/// @brief A Stroker.
+/// @param style How the polylines are drawn.
+Stroker::Stroker(const Style& style) {
+  SetStyle(style);
+}
+
+/// @brief Set how the next polylines are drawn.
+void Stroker::SetStyle(const Style& style) {
+  style_ = style;
+  half_thickness_ = std::abs(style.thickness) * 0.5F;  // NOLINT
+
+  // A chord spanning |arc_step_| is at distance r * (1 - cos(arc_step_ / 2))
+  // from the arc.
+  const float tolerance = std::max(style.tolerance, 0.01F);  // NOLINT
+  arc_step_ = tolerance >= half_thickness_
+                  ? pi
+                  : 2.F * std::acos(1.F - tolerance / half_thickness_);
+  arc_step_ = std::max(arc_step_, pi / 64.F);  // NOLINT
+}
+
+/// @brief Append the stroke of a polyline.
+/// @param points The sequence of points the line is going through.
+void Stroker::Add(const std::vector<glm::vec2>& points) {
+  Add(points.data(), points.size());
+}
+
+/// @brief Append the stroke of a polyline.
+/// @param points The sequence of points the line is going through.
+/// @param size The number of points.
+void Stroker::Add(const glm::vec2* points, size_t size) {
+  if (size == 0 || half_thickness_ == 0.F) {
+    return;
+  }
+
+  // Points closer than this are merged, their direction being meaningless.
+  const float epsilon = half_thickness_ * 1e-4F;  // NOLINT
+
+  glm::vec2 previous = points[0];
+  glm::vec2 previous_direction;
+  bool has_segment = false;
+  for (size_t i = 1; i < size; ++i) {
+    const glm::vec2 delta = points[i] - previous;
+    const float length = glm::length(delta);
+    if (length <= epsilon) {
+      continue;
+    }
+    const glm::vec2 direction = delta / length;
+
+    if (has_segment) {
+      AddJoin(previous, previous_direction, direction);
+    } else {
+      AddCap(previous, -direction);
+    }
+    AddSegment(previous, points[i], Perpendicular(direction) * half_thickness_);
+
+    previous = points[i];
+    previous_direction = direction;
+    has_segment = true;
+  }
+
+  if (has_segment) {
+    AddCap(previous, previous_direction);
+  } else {
+    AddDot(previous);
+  }
+}
+
+/// @brief Remove the triangles. The memory is kept for future use.
+void Stroker::Clear() {
+  vertices_.clear();
+  indices_.clear();
+}
+
+/// @brief Upload the triangles to the GPU.
+VertexArray Stroker::vertex_array() const {
+  return VertexArray(vertices_, indices_);
+}
+
+void Stroker::AddSegment(const glm::vec2& a,
+                         const glm::vec2& b,
+                         const glm::vec2& n) {
+  AddQuad(a + n, a - n, b - n, b + n);
+}
+
+// Fill the gap on the outer side of the turn at |point|.
+void Stroker::AddJoin(const glm::vec2& point,
+                      const glm::vec2& direction_in,
+                      const glm::vec2& direction_out) {
+  const float cross = Cross(direction_in, direction_out);
+  const float dot = glm::dot(direction_in, direction_out);
+
+  // Collinear segments are already connected.
+  constexpr float collinear = 1e-6F;  // NOLINT
+  if (std::abs(cross) < collinear && dot > 0.F) {
+    return;
+  }
+
+  // The outer side is the one opposite to the turn.
+  const float side = cross > 0.F ? -1.F : 1.F;
+  const glm::vec2 normal_in = side * Perpendicular(direction_in);
+  const glm::vec2 normal_out = side * Perpendicular(direction_out);
+  const glm::vec2 a = point + normal_in * half_thickness_;
+  const glm::vec2 b = point + normal_out * half_thickness_;
+
+  switch (style_.join) {
+    case Join::Round:
+      AddArc(point, normal_in * half_thickness_, std::atan2(cross, dot));
+      return;
+
+    case Join::Miter: {
+      // The miter is along the bisector of the two normals. Its length is
+      // half_thickness / cos(theta / 2).
+      const glm::vec2 bisector = normal_in + normal_out;
+      const float bisector_length = glm::length(bisector);
+      const float cos_half_angle = bisector_length * 0.5F;  // NOLINT
+      if (cos_half_angle * style_.miter_limit > 1.F) {
+        const glm::vec2 c = point + bisector / bisector_length *
+                                        (half_thickness_ / cos_half_angle);
+        const auto center = AddVertex(point);
+        const auto index_a = AddVertex(a);
+        const auto index_c = AddVertex(c);
+        const auto index_b = AddVertex(b);
+        indices_.insert(indices_.end(), {center, index_a, index_c,  //
+                                         center, index_c, index_b});
+        return;
+      }
+      break;  // Exceeding the miter limit. Draw a bevel instead.
+    }
+
+    case Join::Bevel:
+      break;
+  }
+
+  const auto center = AddVertex(point);
+  const auto index_a = AddVertex(a);
+  const auto index_b = AddVertex(b);
+  indices_.insert(indices_.end(), {center, index_a, index_b});
+}
+
+// Draw the end of a polyline at |point|, |direction| pointing outward.
+void Stroker::AddCap(const glm::vec2& point, const glm::vec2& direction) {
+  const glm::vec2 n = Perpendicular(direction) * half_thickness_;
+  switch (style_.cap) {
+    case Cap::Butt:
+      return;
+
+    case Cap::Square: {
+      const glm::vec2 extension = direction * half_thickness_;
+      AddQuad(point + n, point - n, point - n + extension,
+              point + n + extension);
+      return;
+    }
+
+    case Cap::Round:
+      AddArc(point, n, -pi);
+      return;
+  }
+}
+
+// Draw a polyline without length. Only the caps are visible.
+void Stroker::AddDot(const glm::vec2& point) {
+  switch (style_.cap) {
+    case Cap::Butt:
+      return;
+
+    case Cap::Square: {
+      const float h = half_thickness_;
+      AddQuad(point + glm::vec2(-h, -h), point + glm::vec2(-h, +h),
+              point + glm::vec2(+h, +h), point + glm::vec2(+h, -h));
+      return;
+    }
+
+    case Cap::Round:
+      AddArc(point, {half_thickness_, 0.F}, 2.F * pi);
+      return;
+  }
+}
+
+// Add a fan of triangles around |center|, from |center| + |start|, rotating by
+// |angle| radians.
+void Stroker::AddArc(const glm::vec2& center,
+                     const glm::vec2& start,
+                     float angle) {
+  const int steps = std::max(1, int(std::ceil(std::abs(angle) / arc_step_)));
+  const float step = angle / float(steps);
+  const float cos_step = std::cos(step);
+  const float sin_step = std::sin(step);
+
+  const auto center_index = AddVertex(center);
+  glm::vec2 radius = start;
+  auto previous_index = AddVertex(center + radius);
+  for (int i = 0; i < steps; ++i) {
+    radius = {
+        radius.x * cos_step - radius.y * sin_step,
+        radius.x * sin_step + radius.y * cos_step,
+    };
+    const auto index = AddVertex(center + radius);
+    indices_.insert(indices_.end(), {center_index, previous_index, index});
+    previous_index = index;
+  }
+}
+
+void Stroker::AddQuad(const glm::vec2& a,
+                      const glm::vec2& b,
+                      const glm::vec2& c,
+                      const glm::vec2& d) {
+  const auto base = GLuint(vertices_.size());
+  AddVertex(a);
+  AddVertex(b);
+  AddVertex(c);
+  AddVertex(d);
+  indices_.insert(indices_.end(), {base + 0, base + 1, base + 2,  //
+                                   base + 0, base + 2, base + 3});
+}
+
+GLuint Stroker::AddVertex(const glm::vec2& position) {
+  vertices_.push_back({position, {0.F, 0.F}});
+  return GLuint(vertices_.size() - 1);
+}
+
+}  // namespace smk
@@ -4,6 +4,7 @@
 
 #include <cstdlib>
 #include <iostream>
+#include <smk/RenderStatistics.hpp>
 #include <smk/Texture.hpp>
 #include <vector>
 
@@ -12,6 +13,40 @@
 
 namespace smk {
 extern bool g_invalidate_textures; // NOLINT
+extern RenderStatistics g_render_statistics;  // NOLINT
+
+namespace {
+
+// The size of a pixel in the client memory.
+size_t PixelSize(GLint format, GLint type) {
+  size_t channels = 4;
+  switch (format) {
+    case GL_RED:
+    case GL_DEPTH_COMPONENT:
+      channels = 1;
+      break;
+    case GL_RG:
+      channels = 2;
+      break;
+    case GL_RGB:
+      channels = 3;
+      break;
+    default:
+      break;
+  }
+  switch (type) {
+    case GL_HALF_FLOAT:
+    case GL_UNSIGNED_SHORT:
+      return 2 * channels;
+    case GL_FLOAT:
+    case GL_UNSIGNED_INT:
+      return 4 * channels;
+    default:
+      return channels;
+  }
+}
+
+}  // namespace
 
 int next_power_of_2(int v) {
   return v;
@@ -90,8 +125,13 @@ void Texture::Load(const uint8_t* data,
                    const Option& option) {
   glGenTextures(1, &id_);
   glBindTexture(GL_TEXTURE_2D, id_);
+  ++g_render_statistics.texture_creations;
   glTexImage2D(GL_TEXTURE_2D, 0, option.internal_format, width, height, 0,
                option.format, option.type, data);
+  if (data) {
+    g_render_statistics.bytes_uploaded += size_t(width) * size_t(height) *
+                                          PixelSize(option.format, option.type);
+  }
   if (option.generate_mipmap) {
     glGenerateMipmap(GL_TEXTURE_2D);
   }
@@ -103,12 +143,13 @@ void Texture::Load(const uint8_t* data,
   g_invalidate_textures = true;
 }
 
-/// @brief Import an already loaded texture. Useful
+/// @brief Import an already loaded texture. It still belongs to the caller,
+/// who must delete it after the last smk::Texture using it.
 /// @param id The OpenGL identifier of the loaded texture.
 /// @param width the image's with.
 /// @param height the image's height.
 Texture::Texture(GLuint id, int width, int height)
-    : id_(id), width_(width), height_(height) {}
+    : id_(id), width_(width), height_(height), owned_(false) {}
 
 /// @brief The null texture.
 Texture::Texture() = default;
@@ -117,15 +158,21 @@ Texture::~Texture() {
 }
 
 void Texture::Release() {
-  int* ref_count = ref_count_;
-  id_ = 0;
-  width_ = -1;
-  height_ = -1;
-
+  // Nothing to do for the null Texture.
   if (!id_) {
     return;
   }
 
+  // Transfert state to local.
+  GLuint id = 0;
+  int* ref_count = nullptr;
+  std::swap(id, id_);
+  std::swap(ref_count, ref_count_);
+  width_ = -1;
+  height_ = -1;
+
+  // Early return without releasing the resource if it is still hold by copy of
+  // this class.
   if (ref_count) {
     --(*ref_count);
     if (*ref_count) {
@@ -135,7 +182,10 @@ void Texture::Release() {
     ref_count = nullptr;
   }
 
-  glDeleteTextures(1, &id_);
+  if (owned_) {
+    glDeleteTextures(1, &id);
+    ++g_render_statistics.texture_deletions;
+  }
 }
 
 Texture::Texture(Texture&& other) noexcept {
@@ -152,6 +202,7 @@ Texture& Texture::operator=(Texture&& other) noexcept {
   std::swap(width_, other.width_);
   std::swap(height_, other.height_);
   std::swap(ref_count_, other.ref_count_);
+  std::swap(owned_, other.owned_);
   return *this;
 }
 
@@ -163,6 +214,7 @@ Texture& Texture::operator=(const Texture& other) {
   id_ = other.id_;
   width_ = other.width_;
   height_ = other.height_;
+  owned_ = other.owned_;
 
   if (!other.id_) {
     return *this;
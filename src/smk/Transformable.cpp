@@ -2,6 +2,7 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 
+#include <cmath>
 #include <glm/gtc/matrix_transform.hpp>
 #include <smk/RenderTarget.hpp>
 #include <smk/Texture.hpp>
@@ -14,6 +15,7 @@ namespace smk {
 /// @param rotation The angle in radian.
 void Transformable::SetRotation(float rotation) {
   rotation_ = rotation;
+  affine_dirty_ = true;
 }
 
 /// @brief Increase the rotation of the object to apply before drawing it.
@@ -21,6 +23,7 @@ void Transformable::SetRotation(float rotation) {
 /// @param rotation The delta of rotation to be added.
 void Transformable::Rotate(float rotation) {
   rotation_ += rotation;
+  affine_dirty_ = true;
 }
 
 /// @brief Set the position of the object to be drawn.
@@ -28,6 +31,7 @@ void Transformable::Rotate(float rotation) {
 /// @param position the position (x,y) of the object.
 void Transformable::SetPosition(const glm::vec2& position) {
   position_ = position;
+  affine_dirty_ = true;
 }
 
 /// @brief Set the position of the object to be drawn.
@@ -36,6 +40,7 @@ void Transformable::SetPosition(const glm::vec2& position) {
 /// @param y The position along the vertical axis.
 void Transformable::SetPosition(float x, float y) {
   position_ = {x, y};
+  affine_dirty_ = true;
 }
 
 /// Increase the position of the object being drawn.
@@ -43,6 +48,7 @@ void Transformable::SetPosition(float x, float y) {
 /// @param move The increment of position (x,y)
 void Transformable::Move(const glm::vec2& move) {
   position_ += move;
+  affine_dirty_ = true;
 }
 
 /// Increase the position of the object being drawn.
@@ -59,6 +65,7 @@ void Transformable::Move(float x, float y) {
 /// @param center The center position (x,y) in the object.
 void Transformable::SetCenter(const glm::vec2& center) {
   center_ = center;
+  affine_dirty_ = true;
 }
 
 /// @brief Set the center of the object. It is used as the rotation center. The
@@ -80,6 +87,7 @@ void Transformable::SetScale(float scale) {
 /// @param scale The ratio of magnification.
 void Transformable::SetScale(const glm::vec2& scale) {
   scale_ = scale;
+  affine_dirty_ = true;
 }
 
 /// @brief Increase or decrease the size of the object being drawn.
@@ -88,38 +96,72 @@ void Transformable::SetScale(const glm::vec2& scale) {
 void Transformable::SetScale(float scale_x, float scale_y) {
   scale_.x = scale_x;
   scale_.y = scale_y;
+  affine_dirty_ = true;
 }
 
 /// @brief Increase or decrease the size of the object being drawn.
 /// @param scale_x The ratio of magnification along the horizontal axis.
 void Transformable::SetScaleX(float scale_x) {
   scale_.x = scale_x;
+  affine_dirty_ = true;
 }
 
 /// @brief Increase or decrease the size of the object being drawn.
 /// @param scale_y The ratio of magnification along the vertical axis.
 void Transformable::SetScaleY(float scale_y) {
   scale_.y = scale_y;
+  affine_dirty_ = true;
 }
 
-/// @brief Increase or decrease the size of the object being drawn.
-/// @return the transformation applied to the object. This is the result of
-///         applying the translation, rotation, center and scaling to the the
-///         object.
-glm::mat4 Transformable::transformation() const {
-  glm::mat4 ret = glm::mat4(1.0);
-  ret = glm::translate(ret, {position_.x, position_.y, 0.0});
+/// @return the 2D affine transformation applied to the object. This is the
+///         result of applying the translation, rotation, center and scaling to
+///         the object. It is cached and only recomputed after a modification.
+const glm::mat3x2& Transformable::affine() const {
+  if (!affine_dirty_) {
+    return affine_;
+  }
+  affine_dirty_ = false;
+
+  float cos_rotation = 1.F;
+  float sin_rotation = 0.F;
   if (rotation_ != 0.F) {
-    ret =
-        // NOLINTNEXTLINE
-        glm::rotate(ret, -rotation_ * (2.F * 3.1415F / 360.F), {0.0, 0.0, 1.0});
+    const float angle = -rotation_ * (2.F * 3.1415F / 360.F);  // NOLINT
+    cos_rotation = std::cos(angle);
+    sin_rotation = std::sin(angle);
   }
-  ret =
-      glm::translate(ret, {-center_.x * scale_.x, -center_.y * scale_.y, 0.F});
-  ret = glm::scale(ret, {scale_.x, scale_.y, 1.0});
+
+  const glm::vec2 axis_x = glm::vec2(cos_rotation, sin_rotation) * scale_.x;
+  const glm::vec2 axis_y = glm::vec2(-sin_rotation, cos_rotation) * scale_.y;
+  affine_[0] = axis_x;
+  affine_[1] = axis_y;
+  affine_[2] = position_ - axis_x * center_.x - axis_y * center_.y;
+  return affine_;
+}
+
+/// @return the transformation applied to the object, as a 4x4 matrix. This is
+///         the result of applying the translation, rotation, center and scaling
+///         to the the object.
+glm::mat4 Transformable::transformation() const {
+  const glm::mat3x2& a = affine();
+  glm::mat4 ret = glm::mat4(1.0);
+  ret[0] = glm::vec4(a[0], 0.F, 0.F);
+  ret[1] = glm::vec4(a[1], 0.F, 0.F);
+  ret[3] = glm::vec4(a[2], 0.F, 1.F);
   return ret;
 }
 
+void Transformable::ApplyTransformation(glm::mat4* view) const {
+  // Equivalent to |*view *= transformation()|, skipping the multiplications
+  // by the constant coefficients of the 2D affine transformation.
+  const glm::mat3x2& a = affine();
+  glm::mat4& v = *view;
+  const glm::vec4 column_0 = v[0] * a[0].x + v[1] * a[0].y;
+  const glm::vec4 column_1 = v[0] * a[1].x + v[1] * a[1].y;
+  v[3] += v[0] * a[2].x + v[1] * a[2].y;
+  v[0] = column_0;
+  v[1] = column_1;
+}
+
 /// @brief Modify the color of the object. The resulting pixel is the
 /// multiplication component wise in between this color and the original pixel
 /// color.
@@ -144,10 +186,14 @@ void TransformableBase::SetVertexArray(VertexArray vertex_array) {
   vertex_array_ = std::move(vertex_array);
 }
 
+void TransformableBase::ApplyTransformation(glm::mat4* view) const {
+  *view *= transformation();
+}
+
 void TransformableBase::Draw(RenderTarget& target, RenderState state) const {
+  ApplyTransformation(&state.view);
   state.color *= color();
   state.texture = texture();
-  state.view *= transformation();
   state.vertex_array = vertex_array();
   state.blend_mode = blend_mode();
   target.Draw(state);
@@ -35,4 +35,45 @@ void Vertex3D::Bind() {
       sizeof(Vertex3D), (void*)offsetof(Vertex3D, texture_position));  // NOLINT
 }
 
+// static
+void Vertex2DColor::Bind() {
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 2, GL_FLOAT, false, sizeof(Vertex2DColor),
+                        (void*)offsetof(Vertex2DColor,  // NOLINT
+                                        space_position));
+  glEnableVertexAttribArray(1);
+  glVertexAttribPointer(1, 2, GL_FLOAT, false, sizeof(Vertex2DColor),
+                        (void*)offsetof(Vertex2DColor,  // NOLINT
+                                        texture_position));
+  glEnableVertexAttribArray(2);
+  glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, true, sizeof(Vertex2DColor),
+                        (void*)offsetof(Vertex2DColor, color));  // NOLINT
+}
+
+// static
+void Vertex2DShape::Bind() {
+  constexpr auto stride = GLsizei(sizeof(Vertex2DShape));
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 2, GL_FLOAT, false, stride,
+                        (void*)offsetof(Vertex2DShape,  // NOLINT
+                                        space_position));
+  glEnableVertexAttribArray(1);
+  glVertexAttribPointer(1, 2, GL_FLOAT, false, stride,
+                        (void*)offsetof(Vertex2DShape,  // NOLINT
+                                        local_position));
+  glEnableVertexAttribArray(2);
+  glVertexAttribPointer(2, 2, GL_FLOAT, false, stride,
+                        (void*)offsetof(Vertex2DShape, half_size));  // NOLINT
+  glEnableVertexAttribArray(3);
+  glVertexAttribPointer(3, 2, GL_FLOAT, false, stride,
+                        (void*)offsetof(Vertex2DShape, radius));  // NOLINT
+  glEnableVertexAttribArray(4);
+  glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, true, stride,
+                        (void*)offsetof(Vertex2DShape, color));  // NOLINT
+  glEnableVertexAttribArray(5);
+  glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, true, stride,
+                        (void*)offsetof(Vertex2DShape,  // NOLINT
+                                        border_color));
+}
+
 }  // namespace smk.
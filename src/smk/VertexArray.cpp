@@ -2,22 +2,82 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 
+#include <algorithm>
+#include <smk/RenderStatistics.hpp>
 #include <smk/VertexArray.hpp>
 
 namespace smk {
+extern bool g_invalidate_vertex_arrays;       // NOLINT
+extern RenderStatistics g_render_statistics;  // NOLINT
+
+namespace {
+
+template <typename T>
+Rectangle ComputeBoundingBox(const std::vector<T>& array) {
+  if (array.empty()) {
+    return {0.F, 0.F, 0.F, 0.F};
+  }
+  Rectangle box = {
+      array[0].space_position.x,
+      array[0].space_position.y,
+      array[0].space_position.x,
+      array[0].space_position.y,
+  };
+  for (const auto& vertex : array) {
+    box.left = std::min(box.left, vertex.space_position.x);
+    box.top = std::min(box.top, vertex.space_position.y);
+    box.right = std::max(box.right, vertex.space_position.x);
+    box.bottom = std::max(box.bottom, vertex.space_position.y);
+  }
+  return box;
+}
+
+// The middle of the range covered by the vertices along the z axis.
+float ComputeCenterZ(const std::vector<Vertex3D>& array) {
+  if (array.empty()) {
+    return 0.F;
+  }
+  float min_z = array[0].space_position.z;
+  float max_z = array[0].space_position.z;
+  for (const auto& vertex : array) {
+    min_z = std::min(min_z, vertex.space_position.z);
+    max_z = std::max(max_z, vertex.space_position.z);
+  }
+  return (min_z + max_z) * 0.5F;  // NOLINT
+}
+
+}  // namespace
 
 VertexArray::VertexArray() = default;
 
 void VertexArray::Allocate(int element_size, void* data) {
   glGenVertexArrays(1, &vao_);
   glBindVertexArray(vao_);
+  ++g_render_statistics.vertex_array_creations;
 
   glGenBuffers(1, &vbo_);
   glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+  ++g_render_statistics.buffer_creations;
 
   glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(size_ * element_size), data,
                GL_STATIC_DRAW);
+  g_render_statistics.bytes_uploaded += size_ * size_t(element_size);
   glEnableVertexAttribArray(0);
+
+  // The RenderTarget assumes the last VertexArray it used is still bound.
+  g_invalidate_vertex_arrays = true;
+}
+
+// Attach an index buffer. The vertex array object must be bound.
+void VertexArray::AllocateIndices(const std::vector<GLuint>& indices) {
+  glGenBuffers(1, &ebo_);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+  ++g_render_statistics.buffer_creations;
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+               GLsizeiptr(indices.size() * sizeof(GLuint)), indices.data(),
+               GL_STATIC_DRAW);
+  g_render_statistics.bytes_uploaded += indices.size() * sizeof(GLuint);
+  size_ = indices.size();
 }
 
 VertexArray::~VertexArray() {
@@ -56,8 +116,11 @@ VertexArray& VertexArray::operator=(const VertexArray& other) {
 
   vbo_ = other.vbo_;
   vao_ = other.vao_;
+  ebo_ = other.ebo_;
   ref_count_ = other.ref_count_;
   size_ = other.size_;
+  bounding_box_ = other.bounding_box_;
+  center_z_ = other.center_z_;
 
   (*ref_count_)++;
   return *this;
@@ -66,7 +129,10 @@ VertexArray& VertexArray::operator=(const VertexArray& other) {
 VertexArray& VertexArray::operator=(VertexArray&& other) noexcept {
   std::swap(vbo_, other.vbo_);
   std::swap(vao_, other.vao_);
+  std::swap(ebo_, other.ebo_);
   std::swap(size_, other.size_);
+  std::swap(bounding_box_, other.bounding_box_);
+  std::swap(center_z_, other.center_z_);
   std::swap(ref_count_, other.ref_count_);
   return *this;
 }
@@ -75,6 +141,7 @@ VertexArray& VertexArray::operator=(VertexArray&& other) noexcept {
 /// @param array A set of 2D triangles.
 VertexArray::VertexArray(const std::vector<Vertex2D>& array) {
   size_ = array.size();
+  bounding_box_ = ComputeBoundingBox(array);
   Allocate(sizeof(Vertex2D), (void*)array.data());
   Vertex2D::Bind();
 }
@@ -83,16 +150,129 @@ VertexArray::VertexArray(const std::vector<Vertex2D>& array) {
 /// @param array A set of 3D triangles.
 VertexArray::VertexArray(const std::vector<Vertex3D>& array) {
   size_ = array.size();
+  bounding_box_ = ComputeBoundingBox(array);
+  center_z_ = ComputeCenterZ(array);
   Allocate(sizeof(Vertex3D), (void*)array.data());
   Vertex3D::Bind();
 }
 
+/// Constructor for a vector of 2D vertices with a color.
+/// @param array A set of 2D triangles.
+VertexArray::VertexArray(const std::vector<Vertex2DColor>& array) {
+  size_ = array.size();
+  bounding_box_ = ComputeBoundingBox(array);
+  Allocate(sizeof(Vertex2DColor), (void*)array.data());
+  Vertex2DColor::Bind();
+}
+
+/// Constructor for indexed 2D vertices.
+/// @param array The vertices.
+/// @param indices A set of 2D triangles, as triplets of indices in |array|.
+VertexArray::VertexArray(const std::vector<Vertex2D>& array,
+                         const std::vector<GLuint>& indices)
+    : VertexArray(array) {
+  AllocateIndices(indices);
+}
+
+/// Constructor for indexed 3D vertices.
+/// @param array The vertices.
+/// @param indices A set of 3D triangles, as triplets of indices in |array|.
+VertexArray::VertexArray(const std::vector<Vertex3D>& array,
+                         const std::vector<GLuint>& indices)
+    : VertexArray(array) {
+  AllocateIndices(indices);
+}
+
+/// Constructor for indexed 2D vertices with a color.
+/// @param array The vertices.
+/// @param indices A set of 2D triangles, as triplets of indices in |array|.
+VertexArray::VertexArray(const std::vector<Vertex2DColor>& array,
+                         const std::vector<GLuint>& indices)
+    : VertexArray(array) {
+  AllocateIndices(indices);
+}
+
+/// Constructor for indexed 2D vertices of smk::ShapeBatch.
+/// @param array The vertices.
+/// @param indices A set of 2D triangles, as triplets of indices in |array|.
+VertexArray::VertexArray(const std::vector<Vertex2DShape>& array,
+                         const std::vector<GLuint>& indices) {
+  size_ = array.size();
+  bounding_box_ = ComputeBoundingBox(array);
+  Allocate(sizeof(Vertex2DShape), (void*)array.data());
+  Vertex2DShape::Bind();
+  AllocateIndices(indices);
+}
+
+/// @brief Replace the vertices. The GPU buffer is orphaned and refilled, which
+/// avoids waiting for the GPU to finish using the previous content.
+///
+/// The GPU buffer is shared with every copies of this VertexArray, but the
+/// size and the bounding box are updated only on this one. Draw this instance,
+/// not an older copy.
+/// @param array The new vertices.
+/// @param size The number of vertices, or indices for an indexed VertexArray,
+///             to be drawn.
+/// @param bounding_box The bounding box of |array|. It isn't recomputed, to
+///                     avoid an additional pass over the vertices.
+void VertexArray::Update(const std::vector<Vertex2DColor>& array,
+                         size_t size,
+                         const Rectangle& bounding_box) {
+  Upload(array.data(), array.size() * sizeof(Vertex2DColor), size,
+         bounding_box);
+}
+
+/// @brief Replace the vertices. @see VertexArray::Update.
+void VertexArray::Update(const std::vector<Vertex2DShape>& array,
+                         size_t size,
+                         const Rectangle& bounding_box) {
+  Upload(array.data(), array.size() * sizeof(Vertex2DShape), size,
+         bounding_box);
+}
+
+void VertexArray::Upload(const void* data,
+                         size_t bytes,
+                         size_t size,
+                         const Rectangle& bounding_box) {
+  // The GL_ARRAY_BUFFER binding isn't part of the vertex array object, so this
+  // doesn't disturb the VertexArray bound by the RenderTarget.
+  glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+  glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(bytes), nullptr, GL_STREAM_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, GLsizeiptr(bytes), data);
+  g_render_statistics.bytes_uploaded += bytes;
+  size_ = size;
+  bounding_box_ = bounding_box;
+}
+
 /// @brief The size of the GPU array.
-/// @return the number of vertices in the GPU array.
+/// @return the number of vertices in the GPU array, or the number of indices
+///         for an indexed VertexArray.
 size_t VertexArray::size() const {
   return size_;
 }
 
+/// @brief Whether the triangles are defined by an index buffer.
+bool VertexArray::indexed() const {
+  return ebo_ != 0;
+}
+
+/// @brief The smallest rectangle containing every vertices. It is computed
+/// once, when the VertexArray is constructed. For 3D vertices, this is the
+/// projection on the (x,y) plane.
+const Rectangle& VertexArray::bounding_box() const {
+  return bounding_box_;
+}
+
+/// @brief The center of the box bounding the vertices, in 3D. For 2D vertices,
+/// z is zero.
+glm::vec3 VertexArray::center() const {
+  return {
+      (bounding_box_.left + bounding_box_.right) * 0.5F,  // NOLINT
+      (bounding_box_.top + bounding_box_.bottom) * 0.5F,  // NOLINT
+      center_z_,
+  };
+}
+
 bool VertexArray::operator==(const smk::VertexArray& other) const {
   return vbo_ == other.vbo_;
 }
@@ -110,9 +290,11 @@ void VertexArray::Release() {
   // Transfert state to local.
   GLuint vbo = 0;
   GLuint vao = 0;
+  GLuint ebo = 0;
   int* ref_count = nullptr;
   std::swap(vbo, vbo_);
   std::swap(vao, vao_);
+  std::swap(ebo, ebo_);
   std::swap(ref_count, ref_count_);
 
   // Early return without releasing the resource if it is still hold by copy of
@@ -128,7 +310,13 @@ void VertexArray::Release() {
 
   // Release the OpenGL objects.
   glDeleteBuffers(1, &vbo);
+  ++g_render_statistics.buffer_deletions;
+  if (ebo) {
+    glDeleteBuffers(1, &ebo);
+    ++g_render_statistics.buffer_deletions;
+  }
   glDeleteVertexArrays(1, &vao);
+  ++g_render_statistics.vertex_array_deletions;
 }
 
 }  // namespace smk.
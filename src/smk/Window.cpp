@@ -3,18 +3,17 @@
 // the LICENSE file.
 
 #include <algorithm>
-#include <chrono>
 #include <cmath>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
 #include <smk/Color.hpp>
+#include <smk/Context.hpp>
 #include <smk/Drawable.hpp>
 #include <smk/Input.hpp>
 #include <smk/InputImpl.hpp>
 #include <smk/OpenGL.hpp>
 #include <smk/View.hpp>
 #include <smk/Window.hpp>
-#include <thread>
 #include <vector>
 
 #ifdef __EMSCRIPTEN__
@@ -24,8 +23,6 @@
 
 namespace smk {
 
-bool g_khr_parallel_shader = false; // NOLINT
-
 namespace {
 
 int g_next_id = 0;                                     // NOLINT
@@ -42,14 +39,9 @@ void GLFWScrollCallback(GLFWwindow* glfw_window,
 
   dynamic_cast<InputImpl*>(&(window->input()))
       ->OnScrollEvent({xoffset, yoffset});
-}
-
-void GLFWErrorCallback(int error, const char* description) {
-  std::cerr << "GFLW error n°" << error << std::endl;
-  std::cerr << "~~~" << std::endl;
-  std::cerr << description << std::endl;
-  std::cerr << "~~~" << std::endl;
-  fprintf(stderr, "Error: %s\n", description); // NOLINT
+#ifdef __EMSCRIPTEN__
+  window->RequestRedraw();
+#endif
 }
 
 #ifdef __EMSCRIPTEN__
@@ -64,6 +56,7 @@ EM_BOOL OnTouchEvent(int eventType,
   }
   static_cast<InputImpl*>(&(window->input()))
       ->OnTouchEvent(eventType, keyEvent);
+  window->RequestRedraw();
   return true;
 }
 
@@ -72,6 +65,26 @@ void MainLoop() {
   return main_loop();
 }
 
+// On desktop, any event wakes up the on-demand rendering. In the browser, the
+// input events are observed explicitly.
+void GLFWKeyCallback(GLFWwindow* glfw_window, int, int, int, int) {
+  if (Window* window = window_by_glfw_window[glfw_window]) {
+    window->RequestRedraw();
+  }
+}
+
+void GLFWMouseButtonCallback(GLFWwindow* glfw_window, int, int, int) {
+  if (Window* window = window_by_glfw_window[glfw_window]) {
+    window->RequestRedraw();
+  }
+}
+
+void GLFWCursorPosCallback(GLFWwindow* glfw_window, double, double) {
+  if (Window* window = window_by_glfw_window[glfw_window]) {
+    window->RequestRedraw();
+  }
+}
+
 EM_JS(void, MakeCanvasSelectable, (int window_id), {
   if (!Module) {
     return;
@@ -86,22 +99,6 @@ EM_JS(void, MakeCanvasSelectable, (int window_id), {
 
 #endif
 
-#if !defined NDEBUG && !defined __EMSCRIPTEN__ && __linux__
-void OpenGLDebugMessageCallback(GLenum /*source*/,
-                                GLenum type,
-                                GLuint /*g_next_id*/,
-                                GLenum /*severity*/,
-                                GLsizei length,
-                                const GLchar* message,
-                                const void* /*userParam*/) {
-  if (type == GL_DEBUG_TYPE_OTHER) {
-    return;
-  }
-  std::cerr << "SMK > OpenGL error: " << std::string(message, length)
-            << std::endl;
-}
-#endif
-
 void GLFWCharCallback(GLFWwindow* glfw_window, unsigned int codepoint) {
   Window* window = window_by_glfw_window[glfw_window];
   if (!window) {
@@ -109,6 +106,9 @@ void GLFWCharCallback(GLFWwindow* glfw_window, unsigned int codepoint) {
   }
   dynamic_cast<InputImpl*>(&(window->input()))
       ->OnCharacterTyped((wchar_t)codepoint);
+#ifdef __EMSCRIPTEN__
+  window->RequestRedraw();
+#endif
 }
 
 }  // namespace
@@ -123,80 +123,36 @@ Window::Window() {
 /// @param width The desired width of the window.
 /// @param height The desired height of the window.
 /// @param title The window's title.
-Window::Window(int width, int height, const std::string& title) {
+Window::Window(int width, int height, const std::string& title)
+    : Window(width, height, title, 4) {}
+
+/// @brief The window construtor.
+/// @param width The desired width of the window.
+/// @param height The desired height of the window.
+/// @param title The window's title.
+/// @param samples The number of samples per pixel used for multisample
+///                antialiasing. Use 0 to disable it, for instance when the
+///                shapes are antialiased by smk::ShapeBatch.
+Window::Window(int width, int height, const std::string& title, int samples) {
   input_ = std::make_unique<InputImpl>();
   id_ = ++g_next_id;
   window_by_id[id_] = this;
   width_ = width;
   height_ = height;
 
-  glfwSetErrorCallback(GLFWErrorCallback);
-  // initialize the GLFW library
-  if (!glfwInit()) {
-    throw std::runtime_error("Couldn't init GLFW");
-  }
-
-  // setting the opengl version
-#ifdef __EMSCRIPTEN__
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
-#else
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
-  glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif
-
-  glfwWindowHint(GLFW_RESIZABLE, GL_TRUE);
-  glfwWindowHint(GLFW_SAMPLES, 4);
-
-  // create the window_
-  window_ = glfwCreateWindow(width_, height_, title.c_str(), nullptr, nullptr);
-  if (!window_) {
-    glfwTerminate();
-    throw std::runtime_error("Couldn't create a window_");
-  }
+  window_ = CreateContext(width_, height_, title, /*visible=*/true, samples);
   window_by_glfw_window[window_] = this;
 
-  glfwMakeContextCurrent(window_);
-
-#ifndef __EMSCRIPTEN__
-  glewExperimental = GL_TRUE;
-  GLenum err = glewInit();
-
-  if (err != GLEW_OK) {
-    glfwTerminate();
-    std::string error = (const char*)glewGetErrorString(err);  // NOLINT
-    throw std::runtime_error("Could initialize GLEW, error = " + error);
-  }
-#endif
-
-#if !defined NDEBUG && !defined __EMSCRIPTEN__ && __linux__
-  glEnable(GL_DEBUG_OUTPUT);
-  glDebugMessageCallback(OpenGLDebugMessageCallback, 0);
-#endif
-
   // get version info
   const GLubyte* renderer = glGetString(GL_RENDERER);
   const GLubyte* version = glGetString(GL_VERSION);
   std::cout << "Renderer: " << renderer << std::endl;
   std::cout << "OpenGL version supported " << version << std::endl;
 
-  // Alpha transparency.
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
   InitRenderTarget();
+  frame_pacer_.SetVSync(FramePacer::VSync::On);
 
-#ifndef __EMSCRIPTEN__
-  if (GLEW_KHR_parallel_shader_compile) {
-    glMaxShaderCompilerThreadsKHR(4);
-    g_khr_parallel_shader = true;
-  }
-#else
-  g_khr_parallel_shader = emscripten_webgl_enable_extension(
-      emscripten_webgl_get_current_context(), "KHR_parallel_shader_compile");
-
+#ifdef __EMSCRIPTEN__
   MakeCanvasSelectable(id_);
 
   module_canvas_selector_ = "[smk='" + std::to_string(id_) + "']";
@@ -209,6 +165,9 @@ Window::Window(int width, int height, const std::string& title) {
                                     true, OnTouchEvent);
   emscripten_set_touchcancel_callback(module_canvas_selector_.c_str(),
                                       (void*)id_, true, OnTouchEvent);
+  glfwSetKeyCallback(window_, GLFWKeyCallback);
+  glfwSetMouseButtonCallback(window_, GLFWMouseButtonCallback);
+  glfwSetCursorPosCallback(window_, GLFWCursorPosCallback);
 #endif
   glfwSetScrollCallback(window_, GLFWScrollCallback);
   glfwSetCharCallback(window_, GLFWCharCallback);
@@ -224,7 +183,12 @@ Window& Window::operator=(Window&& other) noexcept {
   }
   std::swap(window_, other.window_);
   std::swap(time_, other.time_);
-  std::swap(time_last_sleep_, other.time_last_sleep_);
+  std::swap(frame_pacer_, other.frame_pacer_);
+  std::swap(on_demand_, other.on_demand_);
+  redraw_requested_ = other.redraw_requested_.exchange(redraw_requested_);
+  std::swap(animation_end_, other.animation_end_);
+  std::swap(last_redraw_, other.last_redraw_);
+  std::swap(idle_timeout_, other.idle_timeout_);
   std::swap(input_, other.input_);
   std::swap(id_, other.id_);
   std::swap(module_canvas_selector_, other.module_canvas_selector_);
@@ -245,6 +209,9 @@ void Window::Display() {
   // Swap Front and Back buffers (double buffering)
   glfwSwapBuffers(window_);
 
+  PollReadPixels();
+  EndFrameStatistics();
+
   // Detect window_ related changes
   UpdateDimensions();
 
@@ -279,11 +246,27 @@ Input& Window::input() {
 /// @param loop The function to be called for each new frame.
 void Window::ExecuteMainLoopUntil(const std::function<bool(void)>& loop) {
 #ifdef __EMSCRIPTEN__
-  main_loop = [my_loop = loop] { (void)my_loop(); };
+  main_loop = [this, my_loop = loop] {
+    if (on_demand_ && !ShouldRedraw()) {
+      return;
+    }
+    (void)my_loop();
+    frame_pacer_.Wait();
+  };
   emscripten_set_main_loop(&MainLoop, 0, 1);
 #else
-  while (loop()) {
-    LimitFrameRate(60.F); // NOLINT
+  while (true) {
+    if (on_demand_) {
+      WaitForRedraw();
+    }
+    const uint64_t frame = frame_pacer_.frame_count();
+    if (!loop()) {
+      break;
+    }
+    // |loop| might have called LimitFrameRate() itself.
+    if (frame_pacer_.frame_count() == frame) {
+      frame_pacer_.Wait();
+    }
   }
 #endif
 }
@@ -296,12 +279,25 @@ void Window::ExecuteMainLoopUntil(const std::function<bool(void)>& loop) {
 /// @param loop The function to be called for each new frame.
 void Window::ExecuteMainLoop(const std::function<void(void)>& loop) {
 #ifdef __EMSCRIPTEN__
-  main_loop = loop;
+  main_loop = [this, loop] {
+    if (on_demand_ && !ShouldRedraw()) {
+      return;
+    }
+    loop();
+    frame_pacer_.Wait();
+  };
   emscripten_set_main_loop(&MainLoop, 0, 1);
 #else
   while (!input().IsKeyPressed(GLFW_KEY_ESCAPE) && !ShouldClose()) {
+    if (on_demand_) {
+      WaitForRedraw();
+    }
+    const uint64_t frame = frame_pacer_.frame_count();
     loop();
-    LimitFrameRate(60.F); // NOLINT
+    // |loop| might have called LimitFrameRate() itself.
+    if (frame_pacer_.frame_count() == frame) {
+      frame_pacer_.Wait();
+    }
   };
 #endif
 }
@@ -323,17 +319,81 @@ void Window::UpdateDimensions() {
 }
 
 /// If needed, insert pause in the execution to maintain a given framerate.
+/// This sets the frame rate cap of the frame_pacer(), and waits for the next
+/// deadline.
 /// @param fps the desired frame rate.
 void Window::LimitFrameRate(float fps) {
-  const float delta = static_cast<float>(glfwGetTime()) - time_last_sleep_;
-  const float target = 1.f / fps;
-  float sleep_duration = target - delta;
-  sleep_duration = std::min(target, sleep_duration);
-  if (sleep_duration > 0.f) {
-    std::this_thread::sleep_for(
-        std::chrono::microseconds(int(sleep_duration * 1'000'000)));  // NOLINT
+  frame_pacer_.SetFrameRateLimit(fps);
+  frame_pacer_.Wait();
+}
+
+/// @brief Render only when needed, to save CPU, GPU and power while nothing
+/// changes. ExecuteMainLoop then sleeps until:
+/// - some input arrives,
+/// - a redraw is requested, see RequestRedraw(),
+/// - an animation is running, see RequestAnimation(),
+/// - the idle timeout elapses, see SetIdleTimeout().
+/// @param on_demand Whether to render on demand, instead of continuously.
+void Window::SetOnDemandRendering(bool on_demand) {
+  on_demand_ = on_demand;
+  RequestRedraw();
+}
+
+/// @brief Make the main loop draw a new frame, when rendering on demand. This
+/// can be called from any thread.
+void Window::RequestRedraw() {
+  redraw_requested_ = true;
+#ifndef __EMSCRIPTEN__
+  glfwPostEmptyEvent();
+#endif
+}
+
+/// @brief Make the main loop draw continuously, when rendering on demand.
+/// @param duration The duration of the animation, in seconds.
+void Window::RequestAnimation(float duration) {
+  animation_end_ = std::max(animation_end_, glfwGetTime() + double(duration));
+}
+
+/// @brief While rendering on demand, draw a frame at least every |timeout|
+/// seconds, e.g. to refresh a clock.
+/// @param timeout The maximum idle duration, in seconds. Zero or negative waits
+///                indefinitely.
+void Window::SetIdleTimeout(float timeout) {
+  idle_timeout_ = timeout;
+}
+
+// Consume the redraw request.
+bool Window::ShouldRedraw() {
+  const double now = glfwGetTime();
+  const bool redraw = redraw_requested_.exchange(false) ||  //
+                      now < animation_end_ ||               //
+                      (idle_timeout_ > 0.f &&
+                       now - last_redraw_ >= double(idle_timeout_));
+  if (redraw) {
+    last_redraw_ = now;
+  }
+  return redraw;
+}
+
+// Sleep until something happens. Every event wakes up the thread: its frame
+// is drawn.
+void Window::WaitForRedraw() {
+  if (ShouldRedraw()) {
+    return;
+  }
+
+  // The time spent sleeping isn't a frame time.
+  frame_pacer_.Resume();
+  if (idle_timeout_ > 0.f) {
+    const double remaining =
+        last_redraw_ + double(idle_timeout_) - glfwGetTime();
+    glfwWaitEventsTimeout(std::max(remaining, 0.0));
+  } else {
+    glfwWaitEvents();
   }
-  time_last_sleep_ = static_cast<float>(glfwGetTime());
+  redraw_requested_ = false;
+  last_redraw_ = glfwGetTime();
+  time_ = static_cast<float>(last_redraw_);
 }
 
 /// Returns true when the user wants to close the window.